@@ -0,0 +1,174 @@
+// Микробенчмарки Vector против std::vector.
+// Сборка: g++ -std=c++20 -O2 -DNDEBUG benchmark.cpp -o benchmark
+// Каждый замер повторяется несколько раз, печатается лучшее время —
+// так регрессии в EmplaceWithReallocation и диспетчеризации is_movable
+// видны количественно, а не только по счётчикам конструкторов.
+#include "vector.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// 16-байтовая тиковая запись — типичный тривиально копируемый элемент
+struct Tick {
+    int64_t timestamp;
+    double price;
+};
+
+// Перемещаемый, но не копируемый элемент
+struct MoveOnly {
+    MoveOnly() : ptr(make_unique<int>(0)) {
+    }
+    explicit MoveOnly(int value) : ptr(make_unique<int>(value)) {
+    }
+    MoveOnly(MoveOnly&&) noexcept = default;
+    MoveOnly& operator=(MoveOnly&&) noexcept = default;
+    unique_ptr<int> ptr;
+};
+
+// Копируемый элемент без nothrow-перемещения: Vector обязан копировать при росте
+struct CopyOnly {
+    CopyOnly() = default;
+    CopyOnly(const CopyOnly&) = default;
+    CopyOnly& operator=(const CopyOnly&) = default;
+    CopyOnly(CopyOnly&& other) : payload(other.payload) {
+    }
+    CopyOnly& operator=(CopyOnly&& other) {
+        payload = other.payload;
+        return *this;
+    }
+    string payload = "some not so short payload string";
+};
+
+volatile uint64_t do_not_optimize_sink = 0;
+
+template <typename Func>
+double MeasureBest(Func func, int repeats = 5) {
+    double best = 1e100;
+    for (int i = 0; i < repeats; ++i) {
+        const auto start = chrono::steady_clock::now();
+        func();
+        const auto finish = chrono::steady_clock::now();
+        best = min(best, chrono::duration<double, milli>(finish - start).count());
+    }
+    return best;
+}
+
+void Report(const string& name, double ours_ms, double std_ms) {
+    cout << left << setw(44) << name << right << fixed << setprecision(2)
+         << setw(10) << ours_ms << " ms" << setw(10) << std_ms << " ms"
+         << setw(9) << setprecision(2) << std_ms / ours_ms << "x" << endl;
+}
+
+// Рост с нуля без Reserve: кривая реаллокаций
+template <typename Container, typename MakeElem>
+void GrowthCurve(size_t count, MakeElem make_elem) {
+    Container v;
+    for (size_t i = 0; i < count; ++i) {
+        if constexpr (requires { v.push_back(make_elem(i)); }) {
+            v.push_back(make_elem(i));
+        } else {
+            v.PushBack(make_elem(i));
+        }
+    }
+    do_not_optimize_sink = do_not_optimize_sink + reinterpret_cast<uintptr_t>(&v[0]);
+}
+
+template <typename T, typename MakeElem>
+void BenchGrowth(const string& name, size_t count, MakeElem make_elem) {
+    const double ours = MeasureBest([&] { GrowthCurve<Vector<T>>(count, make_elem); });
+    const double baseline = MeasureBest([&] { GrowthCurve<vector<T>>(count, make_elem); });
+    Report(name, ours, baseline);
+}
+
+template <typename T>
+void BenchReserve(const string& name, size_t count) {
+    const double ours = MeasureBest([&] {
+        Vector<T> v(count);
+        v.Reserve(count * 2);
+        do_not_optimize_sink = do_not_optimize_sink + v.Capacity();
+    });
+    const double baseline = MeasureBest([&] {
+        vector<T> v(count);
+        v.reserve(count * 2);
+        do_not_optimize_sink = do_not_optimize_sink + v.capacity();
+    });
+    Report(name, ours, baseline);
+}
+
+void BenchEmplaceFrontMiddle(size_t count) {
+    const double ours_front = MeasureBest([&] {
+        Vector<Tick> v;
+        for (size_t i = 0; i < count; ++i) {
+            v.Emplace(v.begin(), Tick{static_cast<int64_t>(i), 0.0});
+        }
+    });
+    const double std_front = MeasureBest([&] {
+        vector<Tick> v;
+        for (size_t i = 0; i < count; ++i) {
+            v.emplace(v.begin(), Tick{static_cast<int64_t>(i), 0.0});
+        }
+    });
+    Report("Emplace at front, Tick x" + to_string(count), ours_front, std_front);
+
+    const double ours_mid = MeasureBest([&] {
+        Vector<Tick> v;
+        for (size_t i = 0; i < count; ++i) {
+            v.Emplace(v.begin() + v.Size() / 2, Tick{static_cast<int64_t>(i), 0.0});
+        }
+    });
+    const double std_mid = MeasureBest([&] {
+        vector<Tick> v;
+        for (size_t i = 0; i < count; ++i) {
+            v.emplace(v.begin() + v.size() / 2, Tick{static_cast<int64_t>(i), 0.0});
+        }
+    });
+    Report("Emplace at middle, Tick x" + to_string(count), ours_mid, std_mid);
+}
+
+void BenchErase(size_t count) {
+    const double ours = MeasureBest([&] {
+        Vector<Tick> v(count);
+        while (v.Size() > count / 2) {
+            v.Erase(v.begin());
+        }
+    });
+    const double baseline = MeasureBest([&] {
+        vector<Tick> v(count);
+        while (v.size() > count / 2) {
+            v.erase(v.begin());
+        }
+    });
+    Report("Erase front half, Tick x" + to_string(count), ours, baseline);
+}
+
+}  // namespace
+
+int main() {
+    cout << left << setw(44) << "benchmark" << right << setw(13) << "Vector"
+         << setw(13) << "std::vector" << setw(10) << "speedup" << endl;
+
+    BenchGrowth<Tick>("PushBack growth, Tick x3M", 3'000'000, [](size_t i) {
+        return Tick{static_cast<int64_t>(i), 1.0};
+    });
+    BenchGrowth<MoveOnly>("PushBack growth, move-only x1M", 1'000'000, [](size_t i) {
+        return MoveOnly(static_cast<int>(i));
+    });
+    BenchGrowth<CopyOnly>("PushBack growth, copy-only x300K", 300'000, [](size_t) {
+        return CopyOnly{};
+    });
+    BenchReserve<Tick>("Reserve 2x, Tick x3M", 3'000'000);
+    BenchReserve<MoveOnly>("Reserve 2x, move-only x1M", 1'000'000);
+    BenchReserve<CopyOnly>("Reserve 2x, copy-only x300K", 300'000);
+    BenchEmplaceFrontMiddle(30'000);
+    BenchErase(30'000);
+    return static_cast<int>(do_not_optimize_sink & 1);
+}
@@ -0,0 +1,204 @@
+#pragma once
+#include "vector.h"
+#include "small_vector.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// Многопоточное дописывание без общего состояния: каждый поток пишет в свой
+// шард (обычный Vector<T>), который регистрируется под мьютексом один раз при
+// первом обращении потока к контейнеру. Дальше PushBack не синхронизируется
+// вовсе — это обычный однопоточный append. Фаза слияния исчезает: Consolidate
+// забирает список шардов как есть, за O(числа шардов) и без копирования
+// элементов, а итерация сшивает сегменты на лету.
+//
+// Читать (Size, begin/end, Consolidate) можно только после того, как потоки
+// закончили дописывать; одновременные append из разных потоков корректны всегда.
+template <typename T>
+class ConcurrentAppendVector {
+    using ShardList = Vector<std::unique_ptr<Vector<T>>>;
+
+public:
+    ConcurrentAppendVector() = default;
+
+    // Шарды закэшированы в thread_local по адресу контейнера
+    ConcurrentAppendVector(const ConcurrentAppendVector&) = delete;
+    ConcurrentAppendVector& operator = (const ConcurrentAppendVector&) = delete;
+
+    template <typename Type>
+    void PushBack(Type&& value) {
+        LocalShard().PushBack(std::forward<Type>(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        return LocalShard().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Суммарный размер по всем шардам; только после завершения дописывания
+    size_t Size() const {
+        size_t total = 0;
+        for (size_t i = 0; i < shards_.Size(); ++i) {
+            total += shards_[i]->Size();
+        }
+        return total;
+    }
+
+    size_t ShardCount() const noexcept {
+        return shards_.Size();
+    }
+
+    // Результат Consolidate: владеет шардами, итерируется по всем элементам
+    class Consolidated {
+    public:
+        auto begin() const {
+            return Iterator<true>::Begin(shards_);
+        }
+        auto end() const {
+            return Iterator<true>::End(shards_);
+        }
+        auto begin() {
+            return Iterator<false>::Begin(shards_);
+        }
+        auto end() {
+            return Iterator<false>::End(shards_);
+        }
+
+        size_t Size() const {
+            size_t total = 0;
+            for (size_t i = 0; i < shards_.Size(); ++i) {
+                total += shards_[i]->Size();
+            }
+            return total;
+        }
+
+    private:
+        friend class ConcurrentAppendVector;
+        explicit Consolidated(ShardList&& shards) : shards_(std::move(shards)) {
+        }
+        ShardList shards_;
+    };
+
+    // Забирает накопленные шарды без копирования элементов, O(числа шардов);
+    // контейнер пустеет и готов принимать следующую партию
+    Consolidated Consolidate() {
+        std::lock_guard guard(mutex_);
+        id_.store(next_id_.fetch_add(1), std::memory_order_release);  // thread_local кэши устаревают
+        ShardList taken(std::move(shards_));  // перемещение Vector оставляет источник пустым
+        return Consolidated(std::move(taken));
+    }
+
+    auto begin() const {
+        return Iterator<true>::Begin(shards_);
+    }
+    auto end() const {
+        return Iterator<true>::End(shards_);
+    }
+
+private:
+    // Прямой итератор, сшивающий шарды; пустые шарды перешагиваются
+    template <bool IsConst>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+
+        Iterator() = default;
+
+        reference operator * () const {
+            return (*(*shards_)[shard_])[index_];
+        }
+        pointer operator -> () const {
+            return &**this;
+        }
+        Iterator& operator ++ () {
+            ++index_;
+            SkipEmptyShards();
+            return *this;
+        }
+        Iterator operator ++ (int) {
+            Iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+        bool operator == (const Iterator& other) const {
+            return shard_ == other.shard_ && index_ == other.index_;
+        }
+        bool operator != (const Iterator& other) const {
+            return !(*this == other);
+        }
+
+        static Iterator Begin(const ShardList& shards) {
+            Iterator it{&shards, 0, 0};
+            it.SkipEmptyShards();
+            return it;
+        }
+        static Iterator End(const ShardList& shards) {
+            return Iterator{&shards, shards.Size(), 0};
+        }
+
+    private:
+        Iterator(const ShardList* shards, size_t shard, size_t index)
+            : shards_(shards), shard_(shard), index_(index) {
+        }
+
+        void SkipEmptyShards() {
+            while (shard_ < shards_->Size() && index_ >= (*shards_)[shard_]->Size()) {
+                ++shard_;
+                index_ = 0;
+            }
+        }
+
+        const ShardList* shards_ = nullptr;
+        size_t shard_ = 0;
+        size_t index_ = 0;
+    };
+
+    // Шард вызывающего потока; ищется в маленьком thread_local кэше по
+    // адресу контейнера, поколение отсекает записи до последнего Consolidate.
+    // Слот переиспользуется, поэтому кэш держит не больше одной записи на
+    // контейнер, сколько бы раз тот ни консолидировался
+    Vector<T>& LocalShard() {
+        struct CacheEntry {
+            const ConcurrentAppendVector* owner;
+            uint64_t owner_id;
+            Vector<T>* shard;
+        };
+        thread_local SmallVector<CacheEntry, 4> cache;
+        const uint64_t id = id_.load(std::memory_order_acquire);
+        CacheEntry* slot = nullptr;
+        for (CacheEntry& entry : cache) {
+            if (entry.owner == this) {
+                if (entry.owner_id == id) {
+                    return *entry.shard;
+                }
+                slot = &entry;  // запись устарела после Consolidate
+                break;
+            }
+        }
+        Vector<T>* shard = nullptr;
+        {
+            std::lock_guard guard(mutex_);
+            shards_.PushBack(std::make_unique<Vector<T>>());
+            shard = shards_[shards_.Size() - 1].get();
+        }
+        if (slot != nullptr) {
+            *slot = CacheEntry{this, id, shard};
+        } else {
+            cache.PushBack(CacheEntry{this, id, shard});
+        }
+        return *shard;
+    }
+
+    // Идентификаторы уникальны на процесс: устаревшие записи thread_local
+    // кэшей никогда не совпадут с живым контейнером
+    static inline std::atomic<uint64_t> next_id_{1};
+
+    std::atomic<uint64_t> id_{next_id_.fetch_add(1)};
+    std::mutex mutex_;
+    ShardList shards_;
+};
@@ -1,6 +1,22 @@
+// Тесты гоняются со включённой статистикой реаллокаций
+// и параллельным переносом при реаллокации
+#define VECTOR_ENABLE_STATS
+#define VECTOR_ENABLE_PARALLEL_RELOCATION
 #include "vector.h"
+#include "small_vector.h"
+#include "mmap_allocator.h"
+#include "tuple_vector.h"
+#include "concurrent_append_vector.h"
+#include "pool_allocator.h"
+#include "segmented_vector.h"
+#include "numa_allocator.h"
+
+#include <numeric>
+#include <thread>
 
 #include <iostream>
+#include <iterator>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -569,85 +585,1259 @@ void Test6() {
     }
 }
 
-struct C {
-    C() noexcept {
-        ++def_ctor;
+void Test7() {
+    // Быстрый путь через memcpy/memmove для тривиально копируемых типов
+    static_assert(Vector<int>::is_trivially_copyable);
+    static_assert(!Vector<Obj>::is_trivially_copyable);
+    const size_t SIZE = 1000;
+    {
+        Vector<int> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        v.Reserve(SIZE * 4);
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(v[i] == static_cast<int>(i));
+        }
+        auto* pos = v.Insert(v.cbegin() + 10, 42);
+        assert(v.Size() == SIZE + 1);
+        assert(*pos == 42);
+        assert(v[9] == 9);
+        assert(v[11] == 10);
+        pos = v.Erase(v.cbegin() + 10);
+        assert(v.Size() == SIZE);
+        assert(*pos == 10);
+        // Вставка собственного элемента должна быть безопасна и на memmove-пути
+        Vector<int> w;
+        w.Reserve(4);
+        w.PushBack(1);
+        w.PushBack(2);
+        w.Insert(w.cbegin(), w[1]);
+        assert(w[0] == 2 && w[1] == 1 && w[2] == 2);
     }
-    C(const C& /*other*/) noexcept {
-        ++copy_ctor;
+}
+
+namespace {
+
+struct RelocObj {
+    explicit RelocObj(int value) : ptr(std::make_unique<int>(value)) {
     }
-    C(C&& /*other*/) noexcept {
-        ++move_ctor;
+    std::unique_ptr<int> ptr;
+    int64_t tag = 0;
+};
+
+// Аллокатор с reallocate, бросающим по счётчику: проверка отката
+// на realloc-пути роста
+template <typename T>
+struct FlakyReallocAllocator {
+    using value_type = T;
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T)));
     }
-    C& operator=(const C& other) noexcept {
-        if (this != &other) {
-            ++copy_assign;
+
+    void deallocate(T* buf, size_t /*n*/) noexcept {
+        ::operator delete(buf);
+    }
+
+    T* reallocate(T* buf, size_t old_n, size_t new_n) {
+        if (fail_countdown > 0 && --fail_countdown == 0) {
+            throw std::bad_alloc();
         }
-        return *this;
+        T* fresh = allocate(new_n);
+        if (buf != nullptr) {
+            std::memcpy(static_cast<void*>(fresh), static_cast<const void*>(buf),
+                        std::min(old_n, new_n) * sizeof(T));
+            deallocate(buf, old_n);
+        }
+        return fresh;
     }
-    C& operator=(C&& /*other*/) noexcept {
-        ++move_assign;
-        return *this;
+
+    static inline int fail_countdown = 0;
+};
+
+}  // namespace
+
+template <>
+struct IsTriviallyRelocatable<RelocObj> : std::true_type {};
+
+void Test8() {
+    static_assert(!Vector<RelocObj>::is_trivially_copyable);
+    static_assert(Vector<RelocObj>::is_trivially_relocatable);
+    const int SIZE = 100;
+    Vector<RelocObj> v;
+    for (int i = 0; i < SIZE; ++i) {
+        v.EmplaceBack(i);
+    }
+    v.Reserve(SIZE * 4);
+    for (int i = 0; i < SIZE; ++i) {
+        assert(*v[i].ptr == i);
     }
-    ~C() {
-        ++dtor;
+    auto* pos = v.Emplace(v.cbegin() + v.Size(), 42);
+    assert(*pos->ptr == 42);
+    assert(v.Size() == SIZE + 1);
+
+    // Исключение из reallocate при вставке: заготовленное значение
+    // разрушается, вектор остаётся нетронутым
+    {
+        Vector<RelocObj, FlakyReallocAllocator<RelocObj>> w;
+        for (int i = 0; i < 4; ++i) {
+            w.EmplaceBack(i);
+        }
+        assert(w.Size() == w.Capacity());
+        FlakyReallocAllocator<RelocObj>::fail_countdown = 1;
+        bool thrown = false;
+        try {
+            w.Emplace(w.cbegin() + 2, 42);
+        } catch (const std::bad_alloc&) {
+            thrown = true;
+        }
+        FlakyReallocAllocator<RelocObj>::fail_countdown = 0;
+        assert(thrown);
+        assert(w.Size() == 4);
+        for (int i = 0; i < 4; ++i) {
+            assert(*w[i].ptr == i);
+        }
     }
+}
 
-    static void Reset() {
-        def_ctor = 0;
-        copy_ctor = 0;
-        move_ctor = 0;
-        copy_assign = 0;
-        move_assign = 0;
-        dtor = 0;
+void Test9() {
+    const int SPILL = 20;
+    {
+        SmallVector<int, 8> v;
+        assert(v.IsInline());
+        assert(v.Capacity() == 8);
+        for (int i = 0; i < 8; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.IsInline());
+        for (int i = 8; i < SPILL; ++i) {
+            v.PushBack(i);
+        }
+        assert(!v.IsInline());
+        for (int i = 0; i < SPILL; ++i) {
+            assert(v[i] == i);
+        }
+        // Вставка собственного элемента безопасна и при переносе из встроенного буфера
+        SmallVector<int, 2> w;
+        w.PushBack(1);
+        w.PushBack(2);
+        w.PushBack(w[0]);
+        assert(w[2] == 1);
+    }
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, 4> v;
+        for (int i = 0; i < SPILL; ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(v.Size() == SPILL);
+        assert(v[SPILL - 1].id == SPILL - 1);
+        SmallVector<Obj, 4> moved(std::move(v));
+        assert(moved.Size() == SPILL);
+        assert(moved[0].id == 0);
+        SmallVector<Obj, 4> copied(moved);
+        assert(copied.Size() == SPILL);
+        assert(copied[SPILL - 1].id == SPILL - 1);
     }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Перемещение, пока элементы во встроенном буфере
+        SmallVector<Obj, 8> v;
+        v.EmplaceBack(42);
+        SmallVector<Obj, 8> moved(std::move(v));
+        assert(moved.IsInline());
+        assert(moved.Size() == 1);
+        assert(moved[0].id == 42);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
 
-    inline static size_t def_ctor = 0;
-    inline static size_t copy_ctor = 0;
-    inline static size_t move_ctor = 0;
-    inline static size_t copy_assign = 0;
-    inline static size_t move_assign = 0;
-    inline static size_t dtor = 0;
+namespace {
+
+// Простейшая bump-арена: раздаёт память из внешнего буфера, Deallocate — no-op,
+// вся память возвращается сбросом арены целиком
+struct Arena {
+    explicit Arena(size_t bytes) : storage(std::make_unique<char[]>(bytes)), left(bytes) {
+    }
+    std::unique_ptr<char[]> storage;
+    size_t used = 0;
+    size_t left = 0;
+    int num_allocations = 0;
+};
+
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena& arena) noexcept : arena(&arena) {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        void* ptr = arena->storage.get() + arena->used;
+        if (!std::align(alignof(T), bytes, ptr, arena->left)) {
+            throw std::bad_alloc();
+        }
+        arena->used = static_cast<char*>(ptr) - arena->storage.get() + bytes;
+        arena->left -= bytes;
+        ++arena->num_allocations;
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T*, size_t) noexcept {
+    }
+
+    Arena* arena;
 };
 
-void Dump() {
-    using namespace std;
-    cerr << "Def ctors: "sv << C::def_ctor              //
-         << ", Copy ctors: "sv << C::copy_ctor          //
-         << ", Move ctors: "sv << C::move_ctor          //
-         << ", Copy assignments: "sv << C::copy_assign  //
-         << ", Move assignments: "sv << C::move_assign  //
-         << ", Dtors: "sv << C::dtor << endl;
+}  // namespace
+
+void Test10() {
+    Arena arena(1 << 16);
+    {
+        Vector<int, ArenaAllocator<int>> v(ArenaAllocator<int>{arena});
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Size() == 100);
+        assert(v[99] == 99);
+        assert(arena.num_allocations > 0);
+        // Буфер выделен внутри арены, а не в куче
+        assert(reinterpret_cast<char*>(&v[0]) >= arena.storage.get());
+        assert(reinterpret_cast<char*>(&v[0]) < arena.storage.get() + (1 << 16));
+    }
+    {
+        // Поведение по умолчанию не изменилось
+        Vector<int> v(10);
+        assert(v.Size() == 10);
+        static_assert(std::is_same_v<std::decay_t<decltype(v.GetAllocator())>, NewDeleteAllocator<int>>);
+    }
 }
 
-void Benchmark() {
-    using namespace std;
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "std::vector:"sv << endl;
-            C::Reset();
-            vector<C> v(NUM);
-            Dump();
-            v.push_back(c);
+void Test11() {
+    const int SIZE = 100'000;
+    Vector<int, MallocAllocator<int>> v;
+    for (int i = 0; i < SIZE; ++i) {
+        v.PushBack(i);
+    }
+    assert(v.Size() == SIZE);
+    for (int i = 0; i < SIZE; ++i) {
+        assert(v[i] == i);
+    }
+    v.Reserve(SIZE * 4);
+    assert(v.Capacity() == SIZE * 4);
+    assert(v[SIZE - 1] == SIZE - 1);
+    auto* pos = v.Insert(v.cbegin() + 10, 42);
+    assert(*pos == 42);
+    assert(v.Size() == SIZE + 1);
+    assert(v[11] == 10);
+}
+
+namespace {
+
+// Рост в полтора раза и квантование вместимости по 64 элемента
+struct SlowGrowthPolicy {
+    static size_t Grow(size_t capacity, size_t min_needed) {
+        return std::max(min_needed, RoundUp(capacity + capacity / 2));
+    }
+    static size_t RoundUp(size_t requested) {
+        return (requested + 63) / 64 * 64;
+    }
+};
+
+}  // namespace
+
+void Test12() {
+    {
+        Vector<int, NewDeleteAllocator<int>, SlowGrowthPolicy> v;
+        v.PushBack(1);
+        assert(v.Capacity() == 1);
+        v.PushBack(2);
+        assert(v.Capacity() == 64);
+        v.Reserve(100);
+        assert(v.Capacity() == 128);
+        for (int i = 0; i < 200; ++i) {
+            v.PushBack(i);
         }
-        Dump();
-    } catch (...) {
+        assert(v.Capacity() == 320);
+        assert(v.Capacity() % 64 == 0);
+        assert(v[0] == 1 && v[1] == 2);
     }
-    try {
-        const size_t NUM = 10;
-        C c;
+    {
+        // Политика по умолчанию не изменилась
+        Vector<int> v;
+        v.Reserve(100);
+        assert(v.Capacity() == 100);
+        v.Resize(150);
+        assert(v.Capacity() == 150);
+    }
+}
+
+void Test13() {
+    {
+        const std::vector<int> src = {1, 2, 3, 4, 5};
+        Vector<int> v(src.data(), src.data() + src.size());
+        assert(v.Size() == 5);
+        assert(v.Capacity() == 5);
+        assert(v[4] == 5);
+        v.AppendRange(src.begin(), src.end());
+        assert(v.Size() == 10);
+        assert(v[9] == 5);
+        v.Assign(src.begin(), src.begin() + 2);
+        assert(v.Size() == 2);
+        assert(v[0] == 1 && v[1] == 2);
+    }
+    {
+        Obj::ResetCounters();
+        std::vector<Obj> src(10);
+        Vector<Obj> v(src.begin(), src.end());
+        assert(v.Size() == 10);
+        assert(Obj::num_copied == 10);
+        v.AppendRange(src.begin(), src.end());
+        assert(v.Size() == 20);
+        // Assign переиспользует уже построенные элементы
+        const int before = Obj::num_destroyed;
+        v.Assign(src.begin(), src.end());
+        assert(v.Size() == 10);
+        assert(Obj::num_destroyed == before + 10);
+        assert(Obj::num_assigned == 10);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Входные итераторы: размер заранее неизвестен
+        std::istringstream input("10 20 30");
+        Vector<int> v{std::istream_iterator<int>(input), std::istream_iterator<int>()};
+        assert(v.Size() == 3);
+        assert(v[0] == 10 && v[2] == 30);
+    }
+    {
+        // Указатель на другой тип элемента не попадает на путь memcpy:
+        // значения обязаны пройти через конверсию int -> double
+        const int src[3] = {1, 2, 3};
+        Vector<double> v;
+        v.AppendRange(src, src + 3);
+        assert(v.Size() == 3);
+        assert(v[0] == 1.0 && v[1] == 2.0 && v[2] == 3.0);
+        Vector<double> constructed(src, src + 3);
+        assert(constructed[2] == 3.0);
+    }
+}
+
+void Test14() {
+    {
+        Vector<uint8_t> v;
+        v.Resize(1 << 16, default_init);
+        assert(v.Size() == 1 << 16);
+        assert(v.Capacity() == 1 << 16);
+        v.Resize(10, default_init);
+        assert(v.Size() == 10);
+    }
+    {
+        Vector<int> v;
+        v.Resize(100, 42);
+        assert(v.Size() == 100);
+        assert(v[0] == 42 && v[99] == 42);
+        // Заполнение собственным элементом при реаллокации
+        v.Resize(300, v[0]);
+        assert(v.Size() == 300);
+        assert(v[299] == 42);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        v.Resize(10, Obj{7});
+        assert(v.Size() == 10);
+        assert(v[9].id == 7);
+        // 10 копий в буфер + защитная копия value перед реаллокацией
+        assert(Obj::num_copied == 11);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test15() {
+    {
+        Vector<int> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Capacity() == 128);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 100);
+        assert(v.Size() == 100);
+        assert(v[99] == 99);
+        v.ShrinkTo(50);
+        assert(v.Capacity() == 100 && "ShrinkTo не урезает ниже размера");
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(10);
+        v.Reserve(100);
+        const int moves = Obj::num_moved;
+        v.ShrinkToFit();
+        assert(v.Capacity() == 10);
+        assert(Obj::num_moved == moves + 10);
+        assert(Obj::GetAliveObjectCount() == 10);
+        v.PopBack();
+        v.ShrinkTo(0);
+        assert(v.Capacity() == 9);
+        v.Resize(0);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+namespace {
+
+// SIMD-подобная структура с выравниванием шире дефолтного у operator new
+struct alignas(64) AlignedPayload {
+    float lanes[16];
+};
+
+}  // namespace
+
+void Test16() {
+    {
+        Vector<AlignedPayload> v(100);
+        assert(reinterpret_cast<uintptr_t>(&v[0]) % 64 == 0);
+        v.Reserve(1000);
+        assert(reinterpret_cast<uintptr_t>(&v[0]) % 64 == 0);
+        v.EmplaceBack();
+        assert(reinterpret_cast<uintptr_t>(&v[100]) % 64 == 0);
+    }
+#ifdef __linux__
+    {
+        Vector<int64_t, HugePageAllocator<int64_t>> v;
+        v.Resize(1 << 20);
+        assert(v.Size() == 1 << 20);
+        v[0] = 42;
+        v[(1 << 20) - 1] = 43;
+        assert(v[0] == 42);
+        v.PushBack(44);
+        assert(v[1 << 20] == 44);
+    }
+#endif
+}
+namespace {
+
+// Таблица, собираемая в constant evaluation: PushBack, Reserve, Resize,
+// Insert и Erase работают во время компиляции
+constexpr int SumOfSquaresTable(int n) {
+    Vector<int> v;
+    v.Reserve(4);
+    for (int i = 0; i < n; ++i) {
+        v.PushBack(i * i);
+    }
+    v.Insert(v.cbegin(), 100);
+    v.Erase(v.cbegin());
+    v.Resize(static_cast<size_t>(n) + 5);
+    v.Resize(static_cast<size_t>(n));
+    Vector<int> copy(v);
+    int sum = 0;
+    for (size_t i = 0; i < copy.Size(); ++i) {
+        sum += copy[i];
+    }
+    return sum;
+}
+
+constexpr size_t ConstexprAssignSize() {
+    Vector<int> v;
+    v.Resize(3, 7);
+    Vector<int> w;
+    w = v;
+    w.EmplaceBack(8);
+    w.ShrinkToFit();
+    return w.Size() + static_cast<size_t>(w[3]);
+}
+
+}  // namespace
+
+void Test17() {
+    static_assert(SumOfSquaresTable(10) == 285);
+    static_assert(ConstexprAssignSize() == 12);
+    // Рантайм-поведение тех же операций не изменилось
+    assert(SumOfSquaresTable(10) == 285);
+    assert(ConstexprAssignSize() == 12);
+}
+namespace {
+
+size_t last_reported_capacity = 0;
+int num_callback_calls = 0;
+
+void OnRealloc(const void* /*vector*/, size_t new_capacity, size_t /*relocated*/) {
+    last_reported_capacity = new_capacity;
+    ++num_callback_calls;
+}
+
+}  // namespace
+
+void Test18() {
+    const size_t before_total = VectorStats::total_reallocations.load();
+    VectorStats::on_reallocation = &OnRealloc;
+    {
+        Vector<int> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Stats().reallocations == 8);  // 1, 2, 4, ..., 128
+        assert(v.Stats().peak_capacity == 128);
+        assert(v.Stats().elements_relocated == 127);
+        assert(v.WastedCapacity() == 28);
+        v.Reserve(1000);
+        assert(v.Stats().reallocations == 9);
+        assert(v.Stats().peak_capacity == 1000);
+        assert(num_callback_calls == 9);
+        assert(last_reported_capacity == 1000);
+    }
+    VectorStats::on_reallocation = nullptr;
+    assert(VectorStats::total_reallocations.load() >= before_total + 9);
+}
+void Test19() {
+#ifdef __linux__
+    const char* path = "/tmp/advanced_vector_mmap_test.bin";
+    std::remove(path);
+    const int SIZE = 10'000;
+    {
+        auto v = OpenFileBackedVector<int64_t>(path);
+        assert(v.Size() == 0);
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i * 3);
+        }
+        v.ShrinkToFit();
+    }
+    {
+        // Повторное открытие: данные видны без десериализации
+        auto v = OpenFileBackedVector<int64_t>(path);
+        assert(v.Size() == SIZE);
+        for (int i = 0; i < SIZE; ++i) {
+            assert(v[i] == i * 3);
+        }
+        v.PushBack(-1);
+        v.ShrinkToFit();
+    }
+    {
+        auto v = OpenFileBackedVector<int64_t>(path);
+        assert(v.Size() == SIZE + 1);
+        assert(v[SIZE] == -1);
+        // Копия разделяла бы страницы файла с оригиналом, поэтому второе
+        // живое отображение отвергается
+        bool rejected = false;
+        try {
+            auto copy = v;
+        } catch (const std::bad_alloc&) {
+            rejected = true;
+        }
+        assert(rejected);
+        v.PushBack(-2);  // сам вектор после отказа продолжает работать
+        assert(v[SIZE + 1] == -2);
+    }
+    {
+        auto v = OpenFileBackedVector<int64_t>(path);
+        v.Resize(0);
+        v.ShrinkToFit();
+    }
+    {
+        // Опустошённый вектор не воскресает: файл урезан до нуля
+        auto v = OpenFileBackedVector<int64_t>(path);
+        assert(v.Size() == 0);
+        v.PushBack(7);
+        v.ShrinkToFit();
+    }
+    {
+        auto v = OpenFileBackedVector<int64_t>(path);
+        assert(v.Size() == 1 && v[0] == 7);
+    }
+    std::remove(path);
+#endif
+}
+
+void Test20() {
+    Obj::ResetCounters();
+    // Release отдаёт буфер вместе с владением, Adopt принимает его обратно
+    {
+        Vector<Obj> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(Obj(i));
+        }
+        const int alive_before = Obj::GetAliveObjectCount();
+        auto released = v.Release();
+        assert(v.Size() == 0);
+        assert(v.Capacity() == 0);
+        assert(released.size == 10);
+        assert(released.capacity >= 10);
+        assert(Obj::GetAliveObjectCount() == alive_before);  // элементы живы в буфере
+
+        auto adopted = Vector<Obj>::Adopt(released.buffer, released.size, released.capacity);
+        assert(adopted.Size() == 10);
+        assert(adopted.Capacity() == released.capacity);
+        for (int i = 0; i < 10; ++i) {
+            assert(adopted[i].id == i);
+        }
+        adopted.PushBack(Obj(10));
+        assert(adopted.Size() == 11);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    // Усыновление буфера, выделенного напрямую аллокатором
+    {
+        NewDeleteAllocator<int> alloc;
+        int* buf = alloc.allocate(8);
+        for (int i = 0; i < 5; ++i) {
+            new (buf + i) int(i * i);
+        }
+        auto v = Vector<int>::Adopt(buf, 5, 8);
+        assert(v.Size() == 5 && v.Capacity() == 8);
+        assert(v[4] == 16);
+    }
+}
+
+namespace {
+
+struct ThrowingCopy {
+    ThrowingCopy() = default;
+    ThrowingCopy(const ThrowingCopy&) {
+        if (copy_throw_countdown > 0 && --copy_throw_countdown == 0) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+    ThrowingCopy& operator = (const ThrowingCopy&) = default;
+    static inline int copy_throw_countdown = 0;
+};
+
+}  // namespace
+
+void Test21() {
+    TupleVector<int64_t, double, std::string> trades;
+    for (int i = 0; i < 100; ++i) {
+        trades.EmplaceBack(i, i * 0.5, "id" + std::to_string(i));
+    }
+    assert(trades.Size() == 100);
+    assert(trades.Capacity() == 128);
+
+    // Колонки сплошные: скан одного поля не трогает остальные
+    const int64_t* timestamps = trades.Field<0>();
+    int64_t sum = 0;
+    for (size_t i = 0; i < trades.Size(); ++i) {
+        sum += timestamps[i];
+    }
+    assert(sum == 99 * 100 / 2);
+    assert(trades.Get<1>(10) == 5.0);
+    assert(trades.Get<2>(42) == "id42");
+
+    // operator[] собирает запись обратно из колонок
+    auto [ts, price, id] = trades[7];
+    assert(ts == 7 && price == 3.5 && id == "id7");
+    price = 100.0;
+    assert(trades.Get<1>(7) == 100.0);
+
+    trades.Resize(10);
+    assert(trades.Size() == 10);
+    trades.Resize(20);
+    assert(trades.Get<2>(15).empty());
+    trades.PopBack();
+    assert(trades.Size() == 19);
+
+    TupleVector<int64_t, double, std::string> copy(trades);
+    assert(copy.Size() == 19 && copy.Get<2>(5) == "id5");
+    TupleVector<int64_t, double, std::string> moved(std::move(copy));
+    assert(moved.Size() == 19 && copy.Size() == 0);
+    trades = std::move(moved);
+    assert(trades.Size() == 19);
+
+    // Перенос move-only колонки при росте
+    TupleVector<std::unique_ptr<int>, int> owners;
+    for (int i = 0; i < 10; ++i) {
+        owners.EmplaceBack(std::make_unique<int>(i), i);
+    }
+    assert(*owners.Get<0>(9) == 9);
+
+    // Исключение из копирующей колонки после байтового переноса соседней:
+    // владение memcpy-колонки остаётся у источника и освобождается ровно
+    // один раз (без отката копии байтов в новом буфере)
+    {
+        TupleVector<RelocObj, ThrowingCopy> mixed;
+        for (int i = 0; i < 4; ++i) {
+            mixed.EmplaceBack(RelocObj(i), ThrowingCopy{});
+        }
+        // Одна копия уходит на постановку новой записи, вторая — первый
+        // элемент переносимой колонки, третья бросает посреди переноса
+        ThrowingCopy::copy_throw_countdown = 3;
+        bool thrown = false;
+        try {
+            mixed.EmplaceBack(RelocObj(100), ThrowingCopy{});
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        ThrowingCopy::copy_throw_countdown = 0;
+        assert(thrown);
+        assert(mixed.Size() == 4);
+        for (int i = 0; i < 4; ++i) {
+            assert(*mixed.Get<0>(i).ptr == i);
+        }
+    }
+}
+
+void Test22() {
+    // Диапазонный Erase: один сдвиг хвоста вне зависимости от k
+    {
+        Vector<int> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        auto it = v.Erase(v.begin() + 2, v.begin() + 7);
+        assert(v.Size() == 5);
+        assert(*it == 7);
+        assert(v[0] == 0 && v[1] == 1 && v[2] == 7 && v[4] == 9);
+        assert(v.Erase(v.begin(), v.begin()) == v.begin());  // пустой диапазон
+        v.Erase(v.begin(), v.end());
+        assert(v.Size() == 0);
+    }
+    // EraseUnordered: последний элемент встаёт на место удалённого
+    {
+        Vector<std::string> v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack("s" + std::to_string(i));
+        }
+        auto it = v.EraseUnordered(v.begin() + 1);
+        assert(v.Size() == 4);
+        assert(*it == "s4");
+        v.EraseUnordered(v.begin() + 3);  // удаление последнего
+        assert(v.Size() == 3);
+        assert(v[0] == "s0" && v[1] == "s4" && v[2] == "s2");
+    }
+    // EraseIf: один уплотняющий проход, в том числе для move-only элементов
+    {
+        Vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(std::make_unique<int>(i));
+        }
+        const size_t removed = v.EraseIf([](const std::unique_ptr<int>& p) {
+            return *p % 2 == 0;
+        });
+        assert(removed == 5);
+        assert(v.Size() == 5);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(*v[i] == static_cast<int>(2 * i + 1));
+        }
+        assert(v.EraseIf([](const auto&) { return false; }) == 0);
+    }
+    // Счётчики живости: диапазонный Erase разрушает ровно k элементов
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        for (int i = 0; i < 8; ++i) {
+            v.PushBack(Obj(i));
+        }
+        v.Erase(v.begin() + 1, v.begin() + 4);
+        assert(v.Size() == 5);
+        assert(Obj::GetAliveObjectCount() == 5);
+        assert(v[1].id == 4);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test23() {
+    // Быстрый путь EmplaceBack при зарезервированной вместимости:
+    // ни одной реаллокации и корректная ссылка на построенный элемент
+    {
+        Vector<std::string> v;
+        v.Reserve(100);
+        const size_t reallocs_before = v.Stats().reallocations;
+        for (int i = 0; i < 100; ++i) {
+            std::string& ref = v.EmplaceBack(3, 'a' + i % 26);
+            assert(&ref == &v[v.Size() - 1]);
+            assert(ref.size() == 3);
+        }
+        assert(v.Stats().reallocations == reallocs_before);
+        assert(v.Size() == 100 && v.Capacity() == 100);
+    }
+    // Холодный путь: переполнение с аргументом-ссылкой внутрь вектора
+    {
+        Vector<std::string> v;
+        v.PushBack("first");
+        while (v.Size() < v.Capacity()) {
+            v.PushBack("filler");
+        }
+        v.PushBack(v[0]);  // реаллокация, аргумент указывает в старый буфер
+        assert(v[v.Size() - 1] == "first");
+    }
+}
+
+void Test24() {
+    // Порог занижается, чтобы перенос реально разошёлся по потокам
+    const size_t saved_threshold = VectorParallelRelocation::min_elements_per_thread;
+    VectorParallelRelocation::min_elements_per_thread = 1000;
+
+    // memcpy-путь: тривиально копируемые элементы
+    {
+        Vector<int64_t> v;
+        const int SIZE = 100'000;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i);
+        }
+        v.Reserve(2 * SIZE);
+        for (int i = 0; i < SIZE; ++i) {
+            assert(v[i] == i);
+        }
+    }
+    // nothrow-move-путь: каждый кусок переносится и разрушается своим потоком
+    {
+        Vector<std::unique_ptr<int>> v;
+        const int SIZE = 20'000;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(std::make_unique<int>(i));
+        }
+        v.Reserve(2 * SIZE);
+        for (int i = 0; i < SIZE; ++i) {
+            assert(*v[i] == i);
+        }
+    }
+
+    VectorParallelRelocation::min_elements_per_thread = saved_threshold;
+}
+
+void Test25() {
+    const int THREADS = 8;
+    const int PER_THREAD = 10'000;
+    ConcurrentAppendVector<int> ingested;
+    {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < THREADS; ++t) {
+            workers.emplace_back([&ingested, t] {
+                for (int i = 0; i < PER_THREAD; ++i) {
+                    ingested.PushBack(t * PER_THREAD + i);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    assert(ingested.Size() == THREADS * PER_THREAD);
+    assert(ingested.ShardCount() == THREADS);
+
+    // Consolidate забирает шарды без копирования, контейнер готов к новой партии
+    auto batch = ingested.Consolidate();
+    assert(ingested.Size() == 0);
+    assert(batch.Size() == THREADS * PER_THREAD);
+    int64_t sum = std::accumulate(batch.begin(), batch.end(), int64_t{0});
+    const int64_t n = THREADS * PER_THREAD;
+    assert(sum == n * (n - 1) / 2);
+
+    // Внутри шарда порядок вставки сохраняется
+    int previous = -1;
+    bool ordered_within_shards = true;
+    for (auto it = batch.begin(); it != batch.end(); ++it) {
+        if (*it % PER_THREAD != 0 && *it != previous + 1) {
+            ordered_within_shards = false;
+        }
+        previous = *it;
+    }
+    assert(ordered_within_shards);
+
+    // Следующая партия пишется в свежие шарды
+    ingested.PushBack(42);
+    assert(ingested.Size() == 1 && *ingested.begin() == 42);
+
+    // Много циклов Consolidate в одном потоке: запись кэша переиспользуется,
+    // каждая партия — ровно один свежий шард
+    for (int cycle = 0; cycle < 100; ++cycle) {
+        ingested.Consolidate();
+        ingested.PushBack(cycle);
+        ingested.PushBack(cycle + 1);
+        assert(ingested.Size() == 2);
+        assert(ingested.ShardCount() == 1);
+    }
+}
+
+void Test26() {
+    // Clear сохраняет вместимость: повторное наполнение без реаллокаций
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        for (int i = 0; i < 50; ++i) {
+            v.PushBack(Obj(i));
+        }
+        const size_t capacity = v.Capacity();
+        const size_t reallocs = v.Stats().reallocations;
+        v.Clear();
+        assert(v.Size() == 0);
+        assert(v.Capacity() == capacity);
+        assert(Obj::GetAliveObjectCount() == 0);
+        for (int i = 0; i < 50; ++i) {
+            v.PushBack(Obj(i));
+        }
+        assert(v.Stats().reallocations == reallocs);
+    }
+    // Пул: буфер разрушенного вектора переиспользуется следующим той же формы
+    {
+        using PooledVector = Vector<int64_t, RecyclingPoolAllocator<int64_t>>;
         {
-            cerr << "Vector:"sv << endl;
-            C::Reset();
-            Vector<C> v(NUM);
-            Dump();
-            v.PushBack(c);
+            PooledVector warmup;
+            warmup.Reserve(256);
+        }
+        const size_t cached = RecyclingPoolAllocator<int64_t>::CachedBlockCount();
+        assert(cached >= 1);
+        for (int message = 0; message < 100; ++message) {
+            PooledVector v;
+            v.Reserve(256);
+            for (int i = 0; i < 256; ++i) {
+                v.PushBack(i);
+            }
+            assert(v[255] == 255);
+        }
+        // Устоявшийся режим: кэш не растёт, блок ходит туда-обратно
+        assert(RecyclingPoolAllocator<int64_t>::CachedBlockCount() == cached);
+    }
+}
+
+void Test27() {
+    // POD-снимок: один write, один read
+    {
+        struct Record {
+            int64_t key;
+            double value;
+            bool operator == (const Record&) const = default;
+        };
+        Vector<Record> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(Record{i, i * 0.25});
+        }
+        std::stringstream stream;
+        v.WriteTo(stream);
+        auto restored = Vector<Record>::ReadFrom(stream);
+        assert(restored.Size() == v.Size());
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(restored[i] == v[i]);
         }
-        Dump();
-    } catch (...) {
     }
+    // Поэлементный вариант для нетривиальных типов
+    {
+        Vector<std::string> v;
+        v.PushBack("alpha");
+        v.PushBack("");
+        v.PushBack("long enough to skip SSO entirely, one would hope");
+        std::stringstream stream;
+        v.WriteTo(stream, [](std::ostream& out, const std::string& s) {
+            const uint64_t len = s.size();
+            out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+            out.write(s.data(), static_cast<std::streamsize>(len));
+        });
+        auto restored = Vector<std::string>::ReadFrom(stream, [](std::istream& in) {
+            uint64_t len = 0;
+            in.read(reinterpret_cast<char*>(&len), sizeof(len));
+            std::string s(len, '\0');
+            in.read(s.data(), static_cast<std::streamsize>(len));
+            return s;
+        });
+        assert(restored.Size() == 3);
+        assert(restored[0] == v[0] && restored[1] == v[1] && restored[2] == v[2]);
+    }
+    // Оборванный снимок — исключение, а не мусор
+    {
+        Vector<int> v;
+        v.PushBack(1);
+        v.PushBack(2);
+        std::stringstream stream;
+        v.WriteTo(stream);
+        std::string bytes = stream.str();
+        std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+        bool thrown = false;
+        try {
+            Vector<int>::ReadFrom(truncated);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+}
+
+void Test28() {
+    // Ядро переноса напрямую: нечётная длина, хвост меньше 64 байт
+    {
+        const size_t BYTES = 1'000'003;
+        std::vector<unsigned char> src(BYTES);
+        for (size_t i = 0; i < BYTES; ++i) {
+            src[i] = static_cast<unsigned char>(i * 31 + 7);
+        }
+        std::vector<unsigned char> dst(BYTES, 0);
+        const size_t saved = NonTemporalRelocation::min_bytes;
+        NonTemporalRelocation::min_bytes = 4096;  // заставляем streaming-путь
+        RelocateBytes(dst.data(), src.data(), BYTES);
+        NonTemporalRelocation::min_bytes = saved;
+        assert(dst == src);
+    }
+    // Интеграция: рост большого вектора через streaming-перенос
+    {
+        const size_t saved = NonTemporalRelocation::min_bytes;
+        NonTemporalRelocation::min_bytes = 4096;
+        Vector<int64_t> v;
+        const int SIZE = 200'000;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i);
+        }
+        v.Reserve(2 * SIZE);
+        NonTemporalRelocation::min_bytes = saved;
+        for (int i = 0; i < SIZE; ++i) {
+            assert(v[i] == i);
+        }
+    }
+}
+
+void Test29() {
+    // Адреса элементов стабильны через любой рост
+    {
+        SegmentedVector<int, 64> registry;
+        const int SIZE = 10'000;
+        std::vector<const int*> addresses;
+        for (int i = 0; i < SIZE; ++i) {
+            addresses.push_back(&registry.EmplaceBack(i));
+        }
+        assert(registry.Size() == SIZE);
+        assert(registry.ChunkCount() == (SIZE + 63) / 64);
+        for (int i = 0; i < SIZE; ++i) {
+            assert(&registry[i] == addresses[i]);
+            assert(registry[i] == i);
+        }
+        int64_t sum = 0;
+        for (int value : registry) {
+            sum += value;
+        }
+        assert(sum == int64_t{SIZE} * (SIZE - 1) / 2);
+    }
+    // Move-only элементы, Resize в обе стороны, Clear сохраняет куски
+    {
+        SegmentedVector<std::unique_ptr<int>, 16> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(std::make_unique<int>(i));
+        }
+        v.Resize(40);
+        assert(v.Size() == 40 && *v[39] == 39);
+        const size_t chunks = v.ChunkCount();
+        v.Clear();
+        assert(v.Size() == 0 && v.ChunkCount() == chunks);
+        v.Resize(10);
+        assert(v[9] == nullptr);
+    }
+    // Копирование и счётчики живости
+    {
+        Obj::ResetCounters();
+        SegmentedVector<Obj, 8> v;
+        for (int i = 0; i < 20; ++i) {
+            v.EmplaceBack(i);
+        }
+        SegmentedVector<Obj, 8> copy(v);
+        assert(copy.Size() == 20 && copy[13].id == 13);
+        assert(Obj::GetAliveObjectCount() == 40);
+        SegmentedVector<Obj, 8> moved(std::move(copy));
+        assert(moved.Size() == 20 && copy.Size() == 0);
+        assert(Obj::GetAliveObjectCount() == 40);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test30() {
+    // Один проход: элементы строятся сразу из generator(index)
+    {
+        Vector<double> table;
+        table.ResizeWith(1000, [](size_t i) {
+            return i * 0.5;
+        });
+        assert(table.Size() == 1000);
+        assert(table[999] == 499.5);
+        table.AppendWith(500, [](size_t i) {
+            return static_cast<double>(i);
+        });
+        assert(table.Size() == 1500);
+        assert(table[1000] == 1000.0 && table[1499] == 1499.0);
+        table.ResizeWith(100, [](size_t) { return 0.0; });  // усечение
+        assert(table.Size() == 100 && table[99] == 49.5);
+    }
+    // Никакого value-construct + присваивания: ровно один конструктор на элемент
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        v.ResizeWith(25, [](size_t i) {
+            return Obj(static_cast<int>(i));
+        });
+        assert(v.Size() == 25 && v[24].id == 24);
+        assert(Obj::num_default_constructed == 0);
+        assert(Obj::num_copied == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    // Исключение из генератора откатывает дописанное
+    {
+        Vector<std::string> v;
+        v.PushBack("keep");
+        bool thrown = false;
+        try {
+            v.AppendWith(10, [](size_t i) -> std::string {
+                if (i == 5) {
+                    throw std::runtime_error("generator failed");
+                }
+                return std::to_string(i);
+            });
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+        assert(v.Size() == 1 && v[0] == "keep");
+    }
+}
+
+void Test31() {
+    // At эквивалентен operator[] в обычной сборке; под VECTOR_HARDENED_BOUNDS
+    // выход за Size() завершает процесс, под ASan отравленный хвост
+    // вместимости ловится аннотациями контейнера
+    Vector<int> v;
+    for (int i = 0; i < 10; ++i) {
+        v.PushBack(i);
+    }
+    v.Reserve(100);
+    assert(&v.At(3) == &v[3]);
+    assert(v.At(9) == 9);
+    const Vector<int>& cv = v;
+    assert(&cv.At(0) == &cv[0]);
+}
+
+void Test32() {
+    // Параллельный first-touch: содержимое то же, что у обычного Resize
+    {
+        const size_t saved = VectorParallelRelocation::min_elements_per_thread;
+        VectorParallelRelocation::min_elements_per_thread = 1000;
+        Vector<int64_t> v(100'000, first_touch);
+        assert(v.Size() == 100'000);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i] == 0);
+        }
+        v.Resize(200'000, first_touch);
+        assert(v.Size() == 200'000 && v[199'999] == 0);
+        VectorParallelRelocation::min_elements_per_thread = saved;
+    }
+    // Для типов без nothrow-конструктора по умолчанию — обычный Resize
+    {
+        Vector<std::string> v;
+        v.Resize(10, first_touch);
+        assert(v.Size() == 10 && v[9].empty());
+    }
+#ifdef __linux__
+    // Interleave-аллокатор: на одноузловой машине вырождается в mmap
+    {
+        Vector<int64_t, NumaInterleaveAllocator<int64_t>> v;
+        for (int i = 0; i < 10'000; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Size() == 10'000 && v[9'999] == 9'999);
+    }
+#endif
+}
+
+void Test33() {
+    // Одна аллокация ровно под число аргументов
+    {
+        auto v = Vector<int>::Of(1, 2, 3, 4, 5);
+        assert(v.Size() == 5 && v.Capacity() == 5);
+        assert(v[0] == 1 && v[4] == 5);
+        assert(v.Stats().reallocations == 1);
+    }
+    // Move-only элементы — с initializer_list такое не собрать
+    {
+        auto v = Vector<std::unique_ptr<int>>::Of(
+            std::make_unique<int>(10), std::make_unique<int>(20));
+        assert(v.Size() == 2 && *v[0] == 10 && *v[1] == 20);
+    }
+    // Rvalue-аргументы перемещаются, ни одной копии
+    {
+        Obj::ResetCounters();
+        auto v = Vector<Obj>::Of(Obj(1), Obj(2), Obj(3));
+        assert(v.Size() == 3 && v[2].id == 3);
+        assert(Obj::num_copied == 0);
+        assert(Obj::num_moved == 3);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test34() {
+    // Вставка в середину без роста: один сдвиг хвоста
+    {
+        Vector<int> v;
+        v.Reserve(20);
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        const int extra[] = {100, 101, 102};
+        auto it = v.InsertRange(v.begin() + 4, std::begin(extra), std::end(extra));
+        assert(*it == 100);
+        assert(v.Size() == 13);
+        assert(v[3] == 3 && v[4] == 100 && v[6] == 102 && v[7] == 4 && v[12] == 9);
+    }
+    // Брешь шире хвоста и вставка с ростом
+    {
+        Vector<std::string> v;
+        v.PushBack("a");
+        v.PushBack("b");
+        v.PushBack("c");
+        std::vector<std::string> tail = {"x", "y", "z", "w"};
+        v.InsertRange(v.begin() + 2, tail.begin(), tail.end());
+        assert(v.Size() == 7);
+        assert(v[1] == "b" && v[2] == "x" && v[5] == "w" && v[6] == "c");
+        std::vector<std::string> more(50, "m");
+        auto it = v.InsertRange(v.begin() + 1, more.begin(), more.end());  // реаллокация
+        assert(*it == "m");
+        assert(v.Size() == 57);
+        assert(v[0] == "a" && v[50] == "m" && v[51] == "b" && v[56] == "c");
+    }
+    // Move-only элементы при росте и пустой диапазон
+    {
+        Vector<std::unique_ptr<int>> v;
+        v.PushBack(std::make_unique<int>(1));
+        v.PushBack(std::make_unique<int>(4));
+        std::unique_ptr<int> mid[] = {std::make_unique<int>(2), std::make_unique<int>(3)};
+        v.InsertRange(v.begin() + 1, std::make_move_iterator(std::begin(mid)),
+                      std::make_move_iterator(std::end(mid)));
+        assert(v.Size() == 4);
+        for (int i = 0; i < 4; ++i) {
+            assert(*v[i] == i + 1);
+        }
+        assert(v.InsertRange(v.begin(), std::make_move_iterator(mid), std::make_move_iterator(mid)) == v.begin());
+    }
+    // Разнотипный указатель в запас ёмкости: memcpy-путь не применяется,
+    // значения проходят конверсию int -> double
+    {
+        Vector<double> v;
+        v.Reserve(10);
+        v.PushBack(0.5);
+        v.PushBack(9.5);
+        const int src[] = {1, 2, 3};
+        v.InsertRange(v.begin() + 1, src, src + 3);
+        assert(v.Size() == 5);
+        assert(v[0] == 0.5 && v[1] == 1.0 && v[3] == 3.0 && v[4] == 9.5);
+    }
+    // Однопроходный источник буферизуется
+    {
+        std::istringstream input("7 8 9");
+        Vector<int> v = Vector<int>::Of(1, 2);
+        v.InsertRange(v.begin() + 1, std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert(v.Size() == 5);
+        assert(v[0] == 1 && v[1] == 7 && v[3] == 9 && v[4] == 2);
+    }
+    // Счётчики живости на пути с переносом
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        for (int i = 0; i < 6; ++i) {
+            v.PushBack(Obj(i));
+        }
+        Vector<Obj> src;
+        for (int i = 100; i < 103; ++i) {
+            src.PushBack(Obj(i));
+        }
+        v.InsertRange(v.begin() + 3, src.begin(), src.end());
+        assert(v.Size() == 9);
+        assert(v[2].id == 2 && v[3].id == 100 && v[5].id == 102 && v[6].id == 3);
+        assert(Obj::GetAliveObjectCount() == 12);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
 }
 
 int main() {
@@ -658,7 +1848,34 @@ int main() {
         Test4();
         Test5();
         Test6();
-        Benchmark();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
+        Test32();
+        Test33();
+        Test34();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
     }
@@ -0,0 +1,132 @@
+#pragma once
+#include "vector.h"
+
+#ifdef __linux__
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Аллокатор, кладущий буфер вектора в mmap-нутый файл: содержимое переживает
+// рестарты процесса и может превышать RAM — ядро подгружает страницы по
+// обращению, а запись уходит на диск без явной сериализации. Подходит только
+// для тривиально перемещаемых типов: байтовое представление элементов и есть
+// персистентный формат. Предоставляет reallocate, поэтому рост вектора идёт
+// через ftruncate + mremap, как правило без копирования.
+//
+// Файл растёт вместе с вместимостью; чтобы при следующем открытии размер
+// восстановился корректно, завершайте работу вызовом ShrinkToFit().
+//
+// Файл вмещает ровно один живой буфер: все отображения идут с нулевого
+// смещения, так что второй mmap смотрел бы на те же страницы и запись в
+// "копию" меняла бы оригинал. Поэтому allocate отказывает, пока предыдущее
+// отображение не освобождено — в частности, копирование file-backed вектора
+// кидает bad_alloc; для копии откройте другой файл и перелейте элементы.
+template <typename T>
+class MmapFileAllocator {
+public:
+    using value_type = T;
+
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "file-backed storage requires trivially copyable elements");
+
+    explicit MmapFileAllocator(const char* path)
+        : file_(std::make_shared<FileHandle>(path)) {
+    }
+
+    // Сколько элементов уже лежит в файле (для восстановления после рестарта)
+    size_t ExistingElementCount() const {
+        return FileSize() / sizeof(T);
+    }
+
+    T* allocate(size_t n) {
+        // Второе живое отображение было бы псевдонимом первого, а не копией
+        if (file_->mapped) {
+            VECTOR_FAIL_ALLOC;
+        }
+        const size_t bytes = n * sizeof(T);
+        if (bytes > FileSize() && ftruncate(file_->fd, bytes) != 0) {
+            VECTOR_FAIL_ALLOC;
+        }
+        void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file_->fd, 0);
+        if (ptr == MAP_FAILED) {
+            VECTOR_FAIL_ALLOC;
+        }
+        file_->mapped = true;
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        munmap(buf, n * sizeof(T));
+        file_->mapped = false;
+    }
+
+    T* reallocate(T* buf, size_t old_n, size_t new_n) {
+        if (buf == nullptr) {
+            return allocate(new_n);
+        }
+        if (new_n == 0) {
+            // Сжатие до нуля — файл урезается, иначе при следующем открытии
+            // ExistingElementCount() воскресил бы уже удалённые элементы.
+            // ftruncate до munmap: при его отказе отображение остаётся живым
+            if (ftruncate(file_->fd, 0) != 0) {
+                VECTOR_FAIL_ALLOC;
+            }
+            munmap(buf, old_n * sizeof(T));
+            file_->mapped = false;
+            return nullptr;
+        }
+        const size_t new_bytes = new_n * sizeof(T);
+        if (ftruncate(file_->fd, new_bytes) != 0) {
+            VECTOR_FAIL_ALLOC;
+        }
+        void* ptr = mremap(buf, old_n * sizeof(T), new_bytes, MREMAP_MAYMOVE);
+        if (ptr == MAP_FAILED) {
+            VECTOR_FAIL_ALLOC;
+        }
+        return static_cast<T*>(ptr);
+    }
+
+private:
+    // fd разделяется всеми копиями аллокатора (RawMemory передаёт его во
+    // временные буферы при реаллокации) и закрывается с последней из них
+    struct FileHandle {
+        explicit FileHandle(const char* path) : fd(open(path, O_RDWR | O_CREAT, 0644)) {
+            if (fd < 0) {
+                VECTOR_FAIL_ALLOC;
+            }
+        }
+        FileHandle(const FileHandle&) = delete;
+        FileHandle& operator = (const FileHandle&) = delete;
+        ~FileHandle() {
+            close(fd);
+        }
+        int fd;
+        bool mapped = false;  // у файла может быть только одно живое отображение
+    };
+
+    size_t FileSize() const {
+        struct stat st;
+        if (fstat(file_->fd, &st) != 0) {
+            return 0;
+        }
+        return static_cast<size_t>(st.st_size);
+    }
+
+    std::shared_ptr<FileHandle> file_;
+};
+
+// Открывает (или создаёт) вектор, хранящийся в файле path; уже записанные
+// элементы становятся видимыми без копирования — default_init для тривиальных
+// типов не трогает память
+template <typename T>
+Vector<T, MmapFileAllocator<T>> OpenFileBackedVector(const char* path) {
+    MmapFileAllocator<T> alloc(path);
+    const size_t count = alloc.ExistingElementCount();
+    Vector<T, MmapFileAllocator<T>> result(alloc);
+    result.Resize(count, default_init);
+    return result;
+}
+
+#endif  // __linux__
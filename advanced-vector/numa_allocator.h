@@ -0,0 +1,60 @@
+#pragma once
+#include "vector.h"
+
+#ifdef __linux__
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Аллокатор, раскладывающий страницы буфера вперемешку по всем доступным
+// NUMA-узлам: без него большой вектор, заполненный одним потоком, целиком
+// ложится на его узел, и читатели с другого сокета платят за удалённую память
+// весь срок жизни буфера. Interleave усредняет задержку и раздаёт пропускную
+// способность обоих контроллеров. Политика ставится через прямые syscall'ы
+// mbind/get_mempolicy, libnuma не требуется; на одноузловой машине (или при
+// отказе ядра) аллокатор молча вырождается в обычный анонимный mmap.
+//
+// Для чувствительных к локальности читателей парный инструмент — параллельный
+// first-touch (Vector::Resize(n, first_touch)), раскладывающий страницы по
+// узлам потоков-читателей.
+template <typename T>
+struct NumaInterleaveAllocator {
+    using value_type = T;
+
+    T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            VECTOR_FAIL_ALLOC;
+        }
+        BindInterleaved(ptr, bytes);
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        munmap(buf, n * sizeof(T));
+    }
+
+private:
+    // Константы политики памяти из <numaif.h>, чтобы не тянуть libnuma
+    static constexpr int kMpolInterleave = 3;
+    static constexpr unsigned kMpolFMemsAllowed = 1u << 2;
+
+    static void BindInterleaved(void* ptr, size_t bytes) {
+        unsigned long allowed = 0;
+        if (syscall(SYS_get_mempolicy, nullptr, &allowed, sizeof(allowed) * 8,
+                    nullptr, kMpolFMemsAllowed) != 0) {
+            return;
+        }
+        if (allowed == 0 || (allowed & (allowed - 1)) == 0) {
+            return;  // один узел — перемешивать нечего
+        }
+        // Политика best effort: страницы ещё не тронуты, поэтому mbind меняет
+        // только их будущее размещение; отказ не мешает работе
+        syscall(SYS_mbind, ptr, bytes, kMpolInterleave, &allowed, sizeof(allowed) * 8, 0);
+    }
+};
+
+#endif  // __linux__
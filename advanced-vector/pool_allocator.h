@@ -0,0 +1,85 @@
+#pragma once
+#include "vector.h"
+
+#include <bit>
+
+// Пул переиспользует буферы через thread-local фрилисты, разложенные по
+// бакетам-степеням двойки: цикл "построить вектор на сообщение — разрушить"
+// в устоявшемся режиме не делает ни одного обращения к куче, буфер сообщения
+// ходит между allocate и deallocate одного и того же бакета. Футпринт
+// ограничен: в бакете кэшируется не больше kMaxCachedPerBucket блоков,
+// блоки крупнее максимального бакета идут мимо пула; остатки освобождаются
+// при завершении потока. Буферы нельзя передавать между потоками.
+template <typename T>
+class RecyclingPoolAllocator {
+public:
+    using value_type = T;
+
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "over-aligned types would lose alignment in recycled blocks");
+
+    T* allocate(size_t n) {
+        const size_t bucket = Bucket(n * sizeof(T));
+        if (bucket >= kBucketCount) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        FreeList& list = Buckets()[bucket];
+        if (list.head != nullptr) {
+            void* block = list.head;
+            list.head = *static_cast<void**>(block);
+            --list.count;
+            return static_cast<T*>(block);
+        }
+        // Выделяется весь бакет: блок обслужит любой запрос своего бакета
+        return static_cast<T*>(::operator new(size_t(1) << bucket));
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        const size_t bucket = Bucket(n * sizeof(T));
+        FreeList* list = bucket < kBucketCount ? &Buckets()[bucket] : nullptr;
+        if (list == nullptr || list->count >= kMaxCachedPerBucket) {
+            ::operator delete(buf);
+            return;
+        }
+        // Указатель фрилиста живёт в самом блоке — kMinBucketBytes это гарантирует
+        *reinterpret_cast<void**>(buf) = list->head;
+        list->head = buf;
+        ++list->count;
+    }
+
+    // Сколько блоков закэшировано текущим потоком (мониторинг и тесты)
+    static size_t CachedBlockCount() {
+        size_t total = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            total += Buckets()[i].count;
+        }
+        return total;
+    }
+
+private:
+    static constexpr size_t kMinBucketBytes = 16;
+    static constexpr size_t kBucketCount = 24;  // бакеты до 8 МБ
+    static constexpr size_t kMaxCachedPerBucket = 8;
+
+    struct FreeList {
+        void* head = nullptr;
+        size_t count = 0;
+
+        ~FreeList() {
+            while (head != nullptr) {
+                void* next = *static_cast<void**>(head);
+                ::operator delete(head);
+                head = next;
+            }
+        }
+    };
+
+    static size_t Bucket(size_t bytes) {
+        return std::bit_width(std::max(bytes, kMinBucketBytes) - 1);
+    }
+
+    static FreeList* Buckets() {
+        thread_local FreeList buckets[kBucketCount];
+        return buckets;
+    }
+};
@@ -0,0 +1,219 @@
+#pragma once
+#include "vector.h"
+
+#include <bit>
+
+// SegmentedVector растёт кусками фиксированного размера и никогда не переносит
+// элементы: адреса стабильны на всю жизнь объекта, а рост — это выделение
+// одного нового куска и запись указателя в таблицу (таблица может переехать,
+// сами элементы — нет). Индексация O(1) через сдвиг и маску. Плата — нет
+// сплошного буфера, итерация идёт по кускам; это правильный размен для
+// append-heavy реестров, на элементы которых смотрят внешние структуры.
+template <typename T, size_t ChunkCapacity = 1024>
+class SegmentedVector {
+    static_assert(ChunkCapacity > 0 && (ChunkCapacity & (ChunkCapacity - 1)) == 0,
+                  "ChunkCapacity must be a power of two");
+
+public:
+    SegmentedVector() = default;
+
+    explicit SegmentedVector(size_t size) {
+        Resize(size);
+    }
+
+    SegmentedVector(const SegmentedVector& other) {
+        Reserve(other.size_);
+        VECTOR_TRY {
+            for (size_t i = 0; i < other.size_; ++i) {
+                std::construct_at(AddressOf(i), other[i]);
+                ++size_;
+            }
+        } VECTOR_CATCH_ALL {
+            DestroyAll();
+            VECTOR_RETHROW;
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : chunks_(std::move(other.chunks_))
+        , size_(std::exchange(other.size_, 0)) {
+    }
+
+    SegmentedVector& operator = (const SegmentedVector& other) {
+        if (this != &other) {
+            SegmentedVector tmp(other);
+            Swap(tmp);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator = (SegmentedVector&& other) noexcept {
+        if (this != &other) {
+            Swap(other);
+        }
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        DestroyAll();
+    }
+
+    void Swap(SegmentedVector& other) noexcept {
+        chunks_.Swap(other.chunks_);
+        std::swap(size_, other.size_);
+    }
+
+    // Досоздаёт куски под new_capacity элементов; существующие элементы
+    // не трогаются, их адреса не меняются
+    void Reserve(size_t new_capacity) {
+        while (Capacity() < new_capacity) {
+            chunks_.PushBack(RawMemory<T>(ChunkCapacity));
+        }
+    }
+
+    template <typename Type>
+    void PushBack(Type&& value) {
+        EmplaceBack(std::forward<Type>(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            // Лишний кусок при исключении из конструктора остаётся про запас
+            chunks_.PushBack(RawMemory<T>(ChunkCapacity));
+        }
+        T* ptr = std::construct_at(AddressOf(size_), std::forward<Args>(args)...);
+        ++size_;
+        return *ptr;
+    }
+
+    void PopBack() {
+        assert(size_ != 0);
+        std::destroy_at(AddressOf(size_ - 1));
+        --size_;
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            for (size_t i = new_size; i < size_; ++i) {
+                std::destroy_at(AddressOf(i));
+            }
+            size_ = new_size;
+            return;
+        }
+        Reserve(new_size);
+        // При исключении из конструктора уже построенный префикс остаётся
+        while (size_ < new_size) {
+            std::construct_at(AddressOf(size_));
+            ++size_;
+        }
+    }
+
+    // Разрушает элементы, куски остаются выделенными
+    void Clear() noexcept {
+        DestroyAll();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return chunks_.Size() * ChunkCapacity;
+    }
+
+    size_t ChunkCount() const noexcept {
+        return chunks_.Size();
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SegmentedVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return *AddressOf(index);
+    }
+
+    // Прямой итератор по кускам; случайный доступ — через operator[]
+    template <bool IsConst>
+    class BasicIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using Owner = std::conditional_t<IsConst, const SegmentedVector, SegmentedVector>;
+
+        BasicIterator() = default;
+        BasicIterator(Owner* owner, size_t index) : owner_(owner), index_(index) {
+        }
+
+        reference operator * () const {
+            return (*owner_)[index_];
+        }
+        pointer operator -> () const {
+            return &**this;
+        }
+        BasicIterator& operator ++ () {
+            ++index_;
+            return *this;
+        }
+        BasicIterator operator ++ (int) {
+            BasicIterator copy = *this;
+            ++index_;
+            return copy;
+        }
+        bool operator == (const BasicIterator& other) const {
+            return index_ == other.index_;
+        }
+        bool operator != (const BasicIterator& other) const {
+            return index_ != other.index_;
+        }
+
+    private:
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    static constexpr size_t kChunkShift = std::countr_zero(ChunkCapacity);
+    static constexpr size_t kIndexMask = ChunkCapacity - 1;
+
+    Vector<RawMemory<T>> chunks_;
+    size_t size_ = 0;
+
+    T* AddressOf(size_t index) {
+        return chunks_[index >> kChunkShift] + (index & kIndexMask);
+    }
+
+    void DestroyAll() noexcept {
+        for (size_t i = 0; i < size_; ++i) {
+            std::destroy_at(AddressOf(i));
+        }
+        size_ = 0;
+    }
+};
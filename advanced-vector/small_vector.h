@@ -0,0 +1,210 @@
+#pragma once
+#include "vector.h"
+
+// SmallVector хранит до InlineCapacity элементов во встроенном буфере прямо в объекте
+// и выделяет память из кучи через RawMemory только после его переполнения.
+// Короткоживущие векторы из нескольких элементов не делают ни одного вызова operator new.
+template <typename T, size_t InlineCapacity>
+class SmallVector {
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+    static const bool is_movable = std::is_nothrow_move_constructible_v<T> || !(std::is_copy_constructible_v<T>);
+    static const bool is_trivially_relocatable = is_trivially_relocatable_v<T>;
+
+    static_assert(InlineCapacity > 0, "InlineCapacity must be non-zero, use Vector<T> otherwise");
+
+    SmallVector() = default;
+
+    explicit SmallVector(size_t size) {
+        Reserve(size);
+        std::uninitialized_value_construct_n(Data(), size);
+        size_ = size;
+    }
+
+    SmallVector(const SmallVector& other) {
+        Reserve(other.size_);
+        std::uninitialized_copy_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(is_movable || is_trivially_relocatable) {
+        MoveFrom(std::move(other));
+    }
+
+    SmallVector& operator = (const SmallVector& other) {
+        if (this == &other) {
+            return *this;
+        }
+        SmallVector tmp(other);
+        std::destroy_n(Data(), size_);
+        size_ = 0;
+        MoveFrom(std::move(tmp));
+        return *this;
+    }
+
+    SmallVector& operator = (SmallVector&& other) noexcept(is_movable || is_trivially_relocatable) {
+        if (this == &other) {
+            return *this;
+        }
+        std::destroy_n(Data(), size_);
+        size_ = 0;
+        MoveFrom(std::move(other));
+        return *this;
+    }
+
+    ~SmallVector() noexcept {
+        std::destroy_n(Data(), size_);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        RawMemory<T> new_data(new_capacity);
+        Relocate(Data(), size_, new_data.GetAddress());
+        heap_.Swap(new_data);
+        spilled_ = true;
+    }
+
+    template <typename Type>
+    void PushBack(Type&& value) {
+        EmplaceBack(std::forward<Type> (value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ < Capacity()) {
+            T* ptr = new (Data() + size_) T(std::forward<Args> (args)...);
+            ++size_;
+            return *ptr;
+        }
+        // Элемент конструируется до переноса: args могут ссылаться на элементы этого же вектора
+        RawMemory<T> new_data(2 * Capacity());
+        T* ptr = new (new_data + size_) T(std::forward<Args> (args)...);
+        try {
+            Relocate(Data(), size_, new_data.GetAddress());
+        } catch (...) {
+            std::destroy_at(ptr);
+            throw;
+        }
+        heap_.Swap(new_data);
+        spilled_ = true;
+        ++size_;
+        return *ptr;
+    }
+
+    void PopBack() {
+        assert(size_ != 0);
+        std::destroy_at(Data() + size_ - 1);
+        --size_;
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            std::destroy_n(Data() + new_size, size_ - new_size);
+            size_ = new_size;
+            return;
+        }
+        Reserve(new_size);
+        std::uninitialized_value_construct_n(Data() + size_, new_size - size_);
+        size_ = new_size;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return spilled_ ? heap_.Capacity() : InlineCapacity;
+    }
+
+    // true, пока элементы лежат во встроенном буфере
+    bool IsInline() const noexcept {
+        return !spilled_;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SmallVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        // Инвариант: без spilled_ size_ <= InlineCapacity. Подсказка отрезает
+        // невозможную ветку "индекс за встроенным буфером" и связанный с ней
+        // ложный -Warray-bounds у GCC
+        if (!spilled_ && index >= InlineCapacity) {
+            __builtin_unreachable();
+        }
+        return Data()[index];
+    }
+
+    iterator begin() noexcept {
+        return Data();
+    }
+    iterator end() noexcept {
+        return Data() + size_;
+    }
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+    const_iterator end() const noexcept {
+        return Data() + size_;
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    alignas(T) unsigned char inline_buffer_[InlineCapacity * sizeof(T)];
+    RawMemory<T> heap_;
+    size_t size_ = 0;
+    bool spilled_ = false;
+
+    T* Data() noexcept {
+        return spilled_ ? heap_.GetAddress() : reinterpret_cast<T*>(inline_buffer_);
+    }
+
+    const T* Data() const noexcept {
+        return const_cast<SmallVector&>(*this).Data();
+    }
+
+    // Переносит count элементов из src в сырую память dst и разрушает источник
+    static void Relocate(T* src, size_t count, T* dst) {
+        if constexpr (is_trivially_relocatable) {
+            if (count != 0) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+            }
+            return;
+        }
+        if constexpr (is_movable) {
+            std::uninitialized_move_n(src, count, dst);
+        } else {
+            std::uninitialized_copy_n(src, count, dst);
+        }
+        std::destroy_n(src, count);
+    }
+
+    // Забирает содержимое other: буфер из кучи крадётся целиком,
+    // встроенный буфер переносится поэлементно
+    void MoveFrom(SmallVector&& other) {
+        assert(size_ == 0);
+        if (other.spilled_) {
+            heap_.Swap(other.heap_);
+            spilled_ = true;
+            std::swap(size_, other.size_);
+            other.spilled_ = false;
+            return;
+        }
+        // other не spilled, значит size_ <= InlineCapacity; явный клэмп делает
+        // эту границу видимой компилятору — иначе GCC при инлайнинге выводит
+        // -Warray-bounds для заведомо мёртвых обращений за встроенный буфер
+        const size_t count = std::min(other.size_, InlineCapacity);
+        Relocate(reinterpret_cast<T*>(other.inline_buffer_), count, Data());
+        size_ = count;
+        other.size_ = 0;
+    }
+};
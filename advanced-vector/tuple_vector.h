@@ -0,0 +1,309 @@
+#pragma once
+#include "vector.h"
+
+#include <tuple>
+
+// TupleVector хранит записи с полями Ts... колонками (structure of arrays):
+// на каждое поле — собственный RawMemory, размер и вместимость общие для
+// всех колонок. Скан одного поля идёт по сплошной памяти, не затягивая
+// соседние поля в кэш-линии, и автовекторизуется; рост и диспетчеризация
+// переноса (memcpy / move / copy) те же, что у Vector.
+//
+// Строгая гарантия при реаллокации сохраняется, если все колонки переносятся
+// без исключений либо все копированием; в смешанном случае уже перемещённые
+// колонки при исключении из копирующей остаются в moved-from состоянии.
+template <typename... Ts>
+class TupleVector {
+    static_assert(sizeof...(Ts) > 0, "TupleVector requires at least one field");
+
+public:
+    static constexpr size_t field_count = sizeof...(Ts);
+
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    TupleVector() = default;
+
+    explicit TupleVector(size_t size) {
+        Reserve(size);
+        ConstructTail(size, 0);
+        size_ = size;
+    }
+
+    TupleVector(const TupleVector& other) {
+        Reserve(other.size_);
+        size_t constructed = 0;
+        VECTOR_TRY {
+            ForEachColumn(columns_, [&](auto& column, auto index) {
+                std::uninitialized_copy_n(std::get<decltype(index)::value>(other.columns_).GetAddress(),
+                                          other.size_, column.GetAddress());
+                ++constructed;
+            });
+        } VECTOR_CATCH_ALL {
+            DestroyColumnsPrefix(columns_, constructed, 0, other.size_);
+            VECTOR_RETHROW;
+        }
+        size_ = other.size_;
+    }
+
+    TupleVector(TupleVector&& other) noexcept
+        : columns_(std::move(other.columns_))
+        , size_(std::exchange(other.size_, 0)) {
+    }
+
+    TupleVector& operator = (const TupleVector& other) {
+        if (this != &other) {
+            TupleVector tmp(other);
+            Swap(tmp);
+        }
+        return *this;
+    }
+
+    TupleVector& operator = (TupleVector&& other) noexcept {
+        if (this != &other) {
+            Swap(other);
+        }
+        return *this;
+    }
+
+    ~TupleVector() {
+        DestroyColumnsPrefix(columns_, field_count, 0, size_);
+    }
+
+    void Swap(TupleVector& other) noexcept {
+        ForEachColumn(columns_, [&](auto& column, auto index) {
+            column.Swap(std::get<decltype(index)::value>(other.columns_));
+        });
+        std::swap(size_, other.size_);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        RelocateColumns(new_capacity);
+    }
+
+    // Одно значение на каждое поле, в порядке объявления Ts...
+    template <typename... Us>
+    void EmplaceBack(Us&&... fields) {
+        static_assert(sizeof...(Us) == field_count, "one value per field expected");
+        if (size_ == Capacity()) {
+            EmplaceBackWithReallocation(std::forward<Us>(fields)...);
+        } else {
+            ConstructRow(columns_, size_, std::forward<Us>(fields)...);
+        }
+        ++size_;
+    }
+
+    void PushBack(const Ts&... fields) {
+        EmplaceBack(fields...);
+    }
+
+    void PopBack() {
+        assert(size_ != 0);
+        ForEachColumn(columns_, [&](auto& column, auto) {
+            std::destroy_at(column.GetAddress() + size_ - 1);
+        });
+        --size_;
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            ForEachColumn(columns_, [&](auto& column, auto) {
+                std::destroy_n(column.GetAddress() + new_size, size_ - new_size);
+            });
+            size_ = new_size;
+            return;
+        }
+        Reserve(new_size);
+        ConstructTail(new_size, size_);
+        size_ = new_size;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return std::get<0>(columns_).Capacity();
+    }
+
+    // Начало сплошной колонки поля I; длина — Size()
+    template <size_t I>
+    FieldType<I>* Field() noexcept {
+        return std::get<I>(columns_).GetAddress();
+    }
+
+    template <size_t I>
+    const FieldType<I>* Field() const noexcept {
+        return std::get<I>(columns_).GetAddress();
+    }
+
+    template <size_t I>
+    FieldType<I>& Get(size_t index) noexcept {
+        assert(index < size_);
+        return Field<I>()[index];
+    }
+
+    template <size_t I>
+    const FieldType<I>& Get(size_t index) const noexcept {
+        assert(index < size_);
+        return Field<I>()[index];
+    }
+
+    // Запись index как кортеж ссылок на её поля в колонках
+    std::tuple<Ts&...> operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Row(*this, index, std::make_index_sequence<field_count>{});
+    }
+
+    std::tuple<const Ts&...> operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return Row(*this, index, std::make_index_sequence<field_count>{});
+    }
+
+private:
+    std::tuple<RawMemory<Ts>...> columns_;
+    size_t size_ = 0;
+
+    template <typename Columns, typename Func, size_t... Is>
+    static void ForEachColumnImpl(Columns& columns, Func&& func, std::index_sequence<Is...>) {
+        (func(std::get<Is>(columns), std::integral_constant<size_t, Is>{}), ...);
+    }
+
+    template <typename Columns, typename Func>
+    static void ForEachColumn(Columns& columns, Func&& func) {
+        ForEachColumnImpl(columns, std::forward<Func>(func), std::make_index_sequence<field_count>{});
+    }
+
+    template <typename Self, size_t... Is>
+    static auto Row(Self& self, size_t index, std::index_sequence<Is...>) {
+        return std::tie(std::get<Is>(self.columns_).GetAddress()[index]...);
+    }
+
+    // Разрушает элементы [from, to) в первых count колонках
+    static void DestroyColumnsPrefix(std::tuple<RawMemory<Ts>...>& columns,
+                                     size_t count, size_t from, size_t to) {
+        size_t i = 0;
+        ForEachColumn(columns, [&](auto& column, auto) {
+            if (i++ < count) {
+                std::destroy_n(column.GetAddress() + from, to - from);
+            }
+        });
+    }
+
+    // Значение-конструирует элементы [size_, new_size) во всех колонках
+    void ConstructTail(size_t new_size, size_t from) {
+        size_t constructed = 0;
+        VECTOR_TRY {
+            ForEachColumn(columns_, [&](auto& column, auto) {
+                std::uninitialized_value_construct_n(column.GetAddress() + from, new_size - from);
+                ++constructed;
+            });
+        } VECTOR_CATCH_ALL {
+            DestroyColumnsPrefix(columns_, constructed, from, new_size);
+            VECTOR_RETHROW;
+        }
+    }
+
+    // Конструирует запись index во всех колонках из fields с откатом
+    // уже построенных полей при исключении
+    template <typename... Us>
+    static void ConstructRow(std::tuple<RawMemory<Ts>...>& columns, size_t index, Us&&... fields) {
+        size_t constructed = 0;
+        VECTOR_TRY {
+            ConstructRowImpl(columns, index, constructed,
+                             std::make_index_sequence<field_count>{}, std::forward<Us>(fields)...);
+        } VECTOR_CATCH_ALL {
+            DestroyColumnsPrefix(columns, constructed, index, index + 1);
+            VECTOR_RETHROW;
+        }
+    }
+
+    template <size_t... Is, typename... Us>
+    static void ConstructRowImpl(std::tuple<RawMemory<Ts>...>& columns, size_t index,
+                                 size_t& constructed, std::index_sequence<Is...>, Us&&... fields) {
+        ((new (std::get<Is>(columns) + index) Ts(std::forward<Us>(fields)), ++constructed), ...);
+    }
+
+    static std::tuple<RawMemory<Ts>...> AllocateColumns(size_t capacity) {
+        return std::tuple<RawMemory<Ts>...>(RawMemory<Ts>(capacity)...);
+    }
+
+    // Переносит все колонки в new_columns той же диспетчеризацией, что и Vector:
+    // memcpy для тривиально перемещаемых, иначе move либо copy. Источники
+    // разрушаются только после успеха всех колонок
+    void RelocateInto(std::tuple<RawMemory<Ts>...>& new_columns) {
+        size_t relocated = 0;
+        VECTOR_TRY {
+            ForEachColumn(columns_, [&](auto& column, auto index) {
+                using Field = std::remove_pointer_t<decltype(column.GetAddress())>;
+                Field* dst = std::get<decltype(index)::value>(new_columns).GetAddress();
+                if constexpr (is_trivially_relocatable_v<Field>) {
+                    if (size_ != 0) {
+                        std::memcpy(static_cast<void*>(dst),
+                                    static_cast<const void*>(column.GetAddress()),
+                                    size_ * sizeof(Field));
+                    }
+                } else if constexpr (std::is_nothrow_move_constructible_v<Field> || !std::is_copy_constructible_v<Field>) {
+                    std::uninitialized_move_n(column.GetAddress(), size_, dst);
+                } else {
+                    std::uninitialized_copy_n(column.GetAddress(), size_, dst);
+                }
+                ++relocated;
+            });
+        } VECTOR_CATCH_ALL {
+            // memcpy-колонки пропускаются: владение по-прежнему у источника
+            // (его байты не менялись), и их ресурсы освободит деструктор
+            // контейнера при раскрутке — разрушать копию байтов значило бы
+            // освободить то же владение дважды
+            size_t i = 0;
+            ForEachColumn(new_columns, [&](auto& column, auto) {
+                using Field = std::remove_pointer_t<decltype(column.GetAddress())>;
+                if constexpr (!is_trivially_relocatable_v<Field>) {
+                    if (i < relocated) {
+                        std::destroy_n(column.GetAddress(), size_);
+                    }
+                }
+                ++i;
+            });
+            VECTOR_RETHROW;
+        }
+        ForEachColumn(columns_, [&](auto& column, auto) {
+            using Field = std::remove_pointer_t<decltype(column.GetAddress())>;
+            // Источники memcpy-колонок не разрушаются: владение ушло побайтово
+            if constexpr (!is_trivially_relocatable_v<Field>) {
+                std::destroy_n(column.GetAddress(), size_);
+            }
+        });
+    }
+
+    void SwapColumns(std::tuple<RawMemory<Ts>...>& other) noexcept {
+        ForEachColumn(columns_, [&](auto& column, auto index) {
+            column.Swap(std::get<decltype(index)::value>(other));
+        });
+    }
+
+    void RelocateColumns(size_t new_capacity) {
+        std::tuple<RawMemory<Ts>...> new_columns = AllocateColumns(new_capacity);
+        RelocateInto(new_columns);
+        SwapColumns(new_columns);
+    }
+
+    // Элемент конструируется в новых колонках до переноса: fields могут
+    // ссылаться на элементы этого же контейнера
+    template <typename... Us>
+    void EmplaceBackWithReallocation(Us&&... fields) {
+        const size_t new_capacity = DefaultGrowthPolicy::Grow(Capacity(), size_ + 1);
+        std::tuple<RawMemory<Ts>...> new_columns = AllocateColumns(new_capacity);
+        ConstructRow(new_columns, size_, std::forward<Us>(fields)...);
+        VECTOR_TRY {
+            RelocateInto(new_columns);
+        } VECTOR_CATCH_ALL {
+            DestroyColumnsPrefix(new_columns, field_count, size_, size_ + 1);
+            VECTOR_RETHROW;
+        }
+        SwapColumns(new_columns);
+    }
+};
@@ -1,136 +1,567 @@
 #pragma once
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <new>
 #include <utility>
 #include <memory>
 #include <iostream>
 #include <algorithm>
+#include <stdexcept>
 #include <type_traits>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Заголовок собирается и с -fno-exceptions: try/catch-очистка превращается в
+// прямолинейный код, а ошибка выделения завершает процесс
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#define VECTOR_TRY try
+#define VECTOR_CATCH_ALL catch (...)
+#define VECTOR_RETHROW throw
+#define VECTOR_FAIL_ALLOC throw std::bad_alloc()
+#else
+#define VECTOR_TRY if (true)
+#define VECTOR_CATCH_ALL if (false)
+#define VECTOR_RETHROW std::abort()
+#define VECTOR_FAIL_ALLOC std::abort()
+#endif
+
+// Под AddressSanitizer запас вместимости [Size(), Capacity()) размечается
+// отравленным: чтение сырого или уже разрушенного хвоста ловится сразу,
+// хотя для кучи весь блок operator new формально валиден. Вне ASan-сборки
+// слой компилируется в ничто
+#if defined(__SANITIZE_ADDRESS__)
+#define VECTOR_HAS_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define VECTOR_HAS_ASAN 1
+#endif
+#endif
+
+#ifdef VECTOR_HAS_ASAN
+extern "C" void __sanitizer_annotate_contiguous_container(
+    const void* beg, const void* end, const void* old_mid, const void* new_mid);
+#endif
+
+#ifdef VECTOR_ENABLE_STATS
+#include <atomic>
+
+// Статистика реаллокаций — включается только макросом VECTOR_ENABLE_STATS,
+// без него слой компилируется в ничто. Счётчики ведутся на экземпляр и на
+// процесс; колбэк on_reallocation позволяет найти конкретный вектор,
+// виновный в скачке RSS, без подключения heap-профайлера.
+struct VectorStats {
+    size_t reallocations = 0;
+    size_t elements_relocated = 0;
+    size_t peak_capacity = 0;
+
+    static inline std::atomic<size_t> total_reallocations{0};
+    static inline std::atomic<size_t> total_elements_relocated{0};
+
+    // (адрес вектора, новая вместимость, перенесено элементов)
+    using Callback = void (*)(const void* vector, size_t new_capacity, size_t relocated);
+    static inline Callback on_reallocation = nullptr;
+};
+#endif
+
+#ifdef VECTOR_ENABLE_PARALLEL_RELOCATION
+#include <thread>
+#include <vector>
+
+// Параллельный перенос при реаллокации — включается только макросом
+// VECTOR_ENABLE_PARALLEL_RELOCATION и только для типов, переносимых без
+// исключений (memcpy либо nothrow-move): такой перенос упирается в пропускную
+// способность памяти и масштабируется на несколько ядер почти линейно.
+// Порог отсекает векторы, для которых запуск потоков дороже самого переноса.
+struct VectorParallelRelocation {
+    static inline size_t min_elements_per_thread = size_t(1) << 20;
+    static inline unsigned max_threads = 8;
+};
+
+// Раздаёт диапазон из count элементов потокам непрерывными кусками;
+// process_chunk(offset, len) обрабатывает один кусок
+template <typename ProcessChunk>
+void ParallelForChunks(size_t count, ProcessChunk process_chunk) {
+    const size_t per_thread = std::max<size_t>(VectorParallelRelocation::min_elements_per_thread, 1);
+    unsigned threads = static_cast<unsigned>(std::min<size_t>(count / per_thread, VectorParallelRelocation::max_threads));
+    threads = std::min(threads, std::max(1u, std::thread::hardware_concurrency()));
+    if (threads <= 1) {
+        process_chunk(size_t(0), count);
+        return;
+    }
+    const size_t chunk = count / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned i = 0; i + 1 < threads; ++i) {
+        workers.emplace_back(process_chunk, i * chunk, chunk);
+    }
+    // Последний (неровный) кусок обрабатывает текущий поток
+    const size_t done = static_cast<size_t>(threads - 1) * chunk;
+    process_chunk(done, count - done);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// Разбивает перенос count элементов из src в dst на несколько потоков;
+// relocate_chunk(src, count, dst) переносит один непрерывный кусок
+template <typename T, typename RelocateChunk>
+void ParallelRelocate(T* src, size_t count, T* dst, RelocateChunk relocate_chunk) {
+    ParallelForChunks(count, [&](size_t offset, size_t len) {
+        relocate_chunk(src + offset, len, dst + offset);
+    });
+}
+#endif
+
+// Порог для переноса мимо кэша: блоки много больше LLC вытесняли бы
+// обычным memcpy горячие данные соседних потоков
+struct NonTemporalRelocation {
+    static inline size_t min_bytes = size_t(16) << 20;
+};
+
+// Побайтовый перенос для тривиально перемещаемых путей. Крупные блоки
+// пишутся non-temporal store'ами (мимо кэша), источник подтягивается
+// программным prefetch'ем; ниже порога и без SSE2 — обычный memcpy,
+// на малых блоках он быстрее
+inline void RelocateBytes(void* dst, const void* src, size_t bytes) {
+#ifdef __SSE2__
+    if (bytes >= NonTemporalRelocation::min_bytes
+            && reinterpret_cast<uintptr_t>(dst) % 16 == 0) {
+        const char* s = static_cast<const char*>(src);
+        char* d = static_cast<char*>(dst);
+        const size_t chunks = bytes / 64;
+        for (size_t i = 0; i < chunks; ++i) {
+            __builtin_prefetch(s + 512, 0, 0);
+            const __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            const __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+            const __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+            const __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d), x0);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), x1);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), x2);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), x3);
+            s += 64;
+            d += 64;
+        }
+        _mm_sfence();  // non-temporal записи видимы до публикации буфера
+        if (bytes % 64 != 0) {
+            std::memcpy(d, s, bytes % 64);
+        }
+        return;
+    }
+#endif
+    std::memcpy(dst, src, bytes);
+}
+
+// Точка настройки в духе P1144: специализируйте для типов, которые корректно
+// переносятся побайтовым копированием без вызова перемещающего конструктора и
+// деструктора источника (например, структуры из unique_ptr и целых чисел).
+// По умолчанию тривиально перемещаемы только тривиально копируемые типы.
+template <typename T>
+struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = IsTriviallyRelocatable<T>::value;
+
+// Аллокатор по умолчанию: глобальные operator new/delete, как и раньше.
+// Интерфейс совместим со std::allocator, поэтому вместо него можно подставить
+// и std::pmr::polymorphic_allocator, и свой арена/пул-аллокатор.
+template <typename T>
+struct NewDeleteAllocator {
+    using value_type = T;
+
+    constexpr T* allocate(size_t n) {
+        // В constant evaluation operator new недоступен — выделяем через std::allocator
+        if (std::is_constant_evaluated()) {
+            return std::allocator<T>{}.allocate(n);
+        }
+        // Типы с alignas больше дефолтного выравнивания кучи (SIMD-структуры)
+        // требуют форму operator new с явным align_val_t
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+        } else {
+            return static_cast<T*>(operator new(n * sizeof(T)));
+        }
+    }
+
+    constexpr void deallocate(T* buf, size_t n) noexcept {
+        if (std::is_constant_evaluated()) {
+            std::allocator<T>{}.deallocate(buf, n);
+            return;
+        }
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            operator delete(buf, std::align_val_t{alignof(T)});
+        } else {
+            operator delete(buf);
+        }
+    }
+};
+
+#ifdef __linux__
+// Опциональный аллокатор на mmap: буфер выровнен по границе страницы, и для
+// блоков от 2 МБ ядру советуется подложить под них hugepages — меньше TLB-промахов
+// на очень больших векторах
+template <typename T>
+struct HugePageAllocator {
+    using value_type = T;
+
+    static constexpr size_t huge_page_size = size_t{2} << 20;
+
+    T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            VECTOR_FAIL_ALLOC;
+        }
+        if (bytes >= huge_page_size) {
+            madvise(ptr, bytes, MADV_HUGEPAGE);
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* buf, size_t n) noexcept {
+        munmap(buf, n * sizeof(T));
+    }
+};
+#endif
+
+// constexpr-совместимые аналоги std::uninitialized_*: сами алгоритмы не являются
+// constexpr, поэтому в constant evaluation элементы конструируются поэлементно
+// через std::construct_at, а в рантайме вызовы делегируются обычным алгоритмам
+template <typename T, typename... Args>
+constexpr void UninitializedValueConstructN(T* dst, size_t n) {
+    if (std::is_constant_evaluated()) {
+        for (size_t i = 0; i < n; ++i) {
+            std::construct_at(dst + i);
+        }
+    } else {
+        std::uninitialized_value_construct_n(dst, n);
+    }
+}
+
+template <typename T>
+constexpr void UninitializedDefaultConstructN(T* dst, size_t n) {
+    if (std::is_constant_evaluated()) {
+        // default-init недоступен в constant evaluation — конструируем по значению
+        for (size_t i = 0; i < n; ++i) {
+            std::construct_at(dst + i);
+        }
+    } else {
+        std::uninitialized_default_construct_n(dst, n);
+    }
+}
+
 template <typename T>
+constexpr void UninitializedFillN(T* dst, size_t n, const T& value) {
+    if (std::is_constant_evaluated()) {
+        for (size_t i = 0; i < n; ++i) {
+            std::construct_at(dst + i, value);
+        }
+    } else {
+        std::uninitialized_fill_n(dst, n, value);
+    }
+}
+
+template <typename It, typename T>
+constexpr T* UninitializedCopy(It first, It last, T* dst) {
+    if (std::is_constant_evaluated()) {
+        for (; first != last; ++first, ++dst) {
+            std::construct_at(dst, *first);
+        }
+        return dst;
+    }
+    return std::uninitialized_copy(first, last, dst);
+}
+
+template <typename It, typename T>
+constexpr T* UninitializedCopyN(It first, size_t n, T* dst) {
+    if (std::is_constant_evaluated()) {
+        for (size_t i = 0; i < n; ++i, ++first, ++dst) {
+            std::construct_at(dst, *first);
+        }
+        return dst;
+    }
+    return std::uninitialized_copy_n(first, n, dst);
+}
+
+template <typename T>
+constexpr T* UninitializedMoveN(T* src, size_t n, T* dst) {
+    if (std::is_constant_evaluated()) {
+        for (size_t i = 0; i < n; ++i) {
+            std::construct_at(dst + i, std::move(src[i]));
+        }
+        return dst + n;
+    }
+    return std::uninitialized_move_n(src, n, dst).second;
+}
+
+template <typename T>
+constexpr T* UninitializedMove(T* first, T* last, T* dst) {
+    return UninitializedMoveN(first, static_cast<size_t>(last - first), dst);
+}
+
+// Определяет, умеет ли аллокатор расширять блок на месте через
+// reallocate(ptr, old_n, new_n) — realloc-подобный интерфейс
+template <typename Alloc, typename T, typename = void>
+struct AllocHasReallocate : std::false_type {};
+
+template <typename Alloc, typename T>
+struct AllocHasReallocate<Alloc, T, std::void_t<decltype(
+    std::declval<Alloc&>().reallocate(std::declval<T*>(), size_t{}, size_t{}))>> : std::true_type {};
+
+// Аллокатор на malloc/free с поддержкой realloc: для тривиально перемещаемых
+// типов рост вектора часто сводится к обновлению метаданных кучи без копирования
+template <typename T>
+struct MallocAllocator {
+    using value_type = T;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "malloc does not support over-aligned types");
+
+    T* allocate(size_t n) {
+        void* ptr = std::malloc(n * sizeof(T));
+        if (!ptr) {
+            VECTOR_FAIL_ALLOC;
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* buf, size_t /*n*/) noexcept {
+        std::free(buf);
+    }
+
+    T* reallocate(T* buf, size_t /*old_n*/, size_t new_n) {
+        // realloc(buf, 0) не обязан возвращать ненулевой указатель —
+        // сжатие до нуля это просто освобождение
+        if (new_n == 0) {
+            std::free(buf);
+            return nullptr;
+        }
+        void* ptr = std::realloc(buf, new_n * sizeof(T));
+        if (!ptr) {
+            VECTOR_FAIL_ALLOC;
+        }
+        return static_cast<T*>(ptr);
+    }
+};
+
+template <typename T, typename Alloc = NewDeleteAllocator<T>>
 class RawMemory {
 public:
-    
+
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity)
+    constexpr explicit RawMemory(size_t capacity)
         : buffer_(Allocate(capacity))
         , capacity_(capacity) {
     }
-    
+
+    constexpr RawMemory(size_t capacity, const Alloc& alloc)
+        : alloc_(alloc)
+        , buffer_(Allocate(capacity))
+        , capacity_(capacity) {
+    }
+
+    // Принимает во владение уже выделенный буфер, ничего не выделяя;
+    // buf должен быть совместим с аллокатором Alloc
+    constexpr RawMemory(T* buf, size_t capacity, const Alloc& alloc)
+        : alloc_(alloc)
+        , buffer_(buf)
+        , capacity_(capacity) {
+    }
+
     RawMemory(const RawMemory&) = delete;
     RawMemory& operator = (const RawMemory&) = delete;
-    
-    RawMemory(RawMemory&& other) {
-        buffer_ = std::move(other.buffer_);
-        capacity_ = other.capacity_;
+
+    constexpr RawMemory(RawMemory&& other) {
+        alloc_ = std::move(other.alloc_);
+        buffer_ = std::exchange(other.buffer_, nullptr);
+        capacity_ = std::exchange(other.capacity_, 0);
     }
-    
-    RawMemory& operator = (RawMemory&& other) {
+
+    constexpr RawMemory& operator = (RawMemory&& other) {
         if (this == &other) {
             return *this;
         }
-        buffer_ = std::move(other.buffer_);
-        capacity_ = other.capacity_;
+        Deallocate(buffer_, capacity_);
+        alloc_ = std::move(other.alloc_);
+        buffer_ = std::exchange(other.buffer_, nullptr);
+        capacity_ = std::exchange(other.capacity_, 0);
         return *this;
     }
 
-    ~RawMemory() {
-        Deallocate(buffer_);
+    constexpr ~RawMemory() {
+        Deallocate(buffer_, capacity_);
     }
 
-    T* operator+(size_t offset) noexcept {
+    constexpr T* operator+(size_t offset) noexcept {
         // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
         assert(offset <= capacity_);
         return buffer_ + offset;
     }
 
-    const T* operator+(size_t offset) const noexcept {
+    constexpr const T* operator+(size_t offset) const noexcept {
         return const_cast<RawMemory&>(*this) + offset;
     }
 
-    const T& operator[](size_t index) const noexcept {
+    constexpr const T& operator[](size_t index) const noexcept {
         return const_cast<RawMemory&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
+    constexpr T& operator[](size_t index) noexcept {
         assert(index < capacity_);
         return buffer_[index];
     }
 
-    void Swap(RawMemory& other) noexcept {
+    constexpr void Swap(RawMemory& other) noexcept {
+        std::swap(alloc_, other.alloc_);
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
     }
 
-    const T* GetAddress() const noexcept {
+    constexpr const T* GetAddress() const noexcept {
         return buffer_;
     }
 
-    T* GetAddress() noexcept {
+    constexpr T* GetAddress() noexcept {
         return buffer_;
     }
 
-    size_t Capacity() const {
+    constexpr size_t Capacity() const {
         return capacity_;
     }
 
+    constexpr const Alloc& GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Отдаёт буфер вызывающему вместе с владением; RawMemory остаётся пустой
+    constexpr T* Release() noexcept {
+        capacity_ = 0;
+        return std::exchange(buffer_, nullptr);
+    }
+
+    // Расширяет буфер на месте средствами аллокатора; содержимое переносится
+    // побайтово, поэтому вызывать можно только для тривиально перемещаемых типов
+    constexpr void Reallocate(size_t new_capacity) {
+        static_assert(AllocHasReallocate<Alloc, T>::value);
+        buffer_ = alloc_.reallocate(buffer_, capacity_, new_capacity);
+        capacity_ = new_capacity;
+    }
+
 private:
     // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    constexpr T* Allocate(size_t n) {
+        return n != 0 ? alloc_.allocate(n) : nullptr;
     }
 
     // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept {
+    constexpr void Deallocate(T* buf, size_t n) noexcept {
         if (buf) {
-            operator delete(buf);
+            alloc_.deallocate(buf, n);
         }
     }
 
+    Alloc alloc_;
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
 };
 
-template <typename T>
+// Тег для Resize без инициализации новых элементов: тривиальные типы остаются
+// неинициализированными, и страницы буфера не трогаются до первой записи
+struct DefaultInitTag {};
+inline constexpr DefaultInitTag default_init;
+
+// Тег параллельной first-touch инициализации: новый хвост value-конструируется
+// несколькими потоками, поэтому на NUMA-машинах страницы ложатся на узлы тех
+// потоков, что их тронули, а не целиком на узел одного писателя. Требует
+// VECTOR_ENABLE_PARALLEL_RELOCATION, без него эквивалентен обычному Resize
+struct FirstTouchTag {};
+inline constexpr FirstTouchTag first_touch;
+
+// Политика роста по умолчанию: удвоение вместимости при добавлении в полный
+// вектор и ровно запрошенная вместимость для Reserve/Resize — как и раньше.
+// Своя политика позволяет, например, расти в 1.5 раза или квантовать
+// вместимость под кратность hugepage.
+struct DefaultGrowthPolicy {
+    // Вместимость при добавлении элемента, когда свободного места нет
+    static constexpr size_t Grow(size_t capacity, size_t min_needed) {
+        return std::max(min_needed, capacity == 0 ? 1 : 2 * capacity);
+    }
+
+    // Вместимость под явный запрос Reserve/Resize
+    static constexpr size_t RoundUp(size_t requested) {
+        return requested;
+    }
+};
+
+template <typename T, typename Alloc = NewDeleteAllocator<T>, typename Growth = DefaultGrowthPolicy>
 class Vector {
 public:
     using iterator = T*;
     using const_iterator = const T*;
     static const bool is_movable = std::is_nothrow_move_constructible_v<T> || !(std::is_copy_constructible_v<T>);
+    // Тривиально копируемые типы можно переносить и сдвигать побайтово через memcpy/memmove
+    static const bool is_trivially_copyable = std::is_trivially_copyable_v<T>;
+    // Перенос в новый буфер (без присваиваний) допустим и для типов, помеченных IsTriviallyRelocatable
+    static const bool is_trivially_relocatable = is_trivially_relocatable_v<T>;
     
     Vector() = default;
-    
-    explicit Vector(size_t size) : data_(size), size_(size) {
-        std::uninitialized_value_construct_n(data_.GetAddress(), size);
+
+    constexpr explicit Vector(const Alloc& alloc) : data_(0, alloc) {
     }
-    
-    Vector(const Vector& other)
-        : data_(other.size_), size_(other.size_) {
-        std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());
+
+    constexpr explicit Vector(size_t size, const Alloc& alloc = Alloc()) : data_(size, alloc), size_(size) {
+        Annotate(Capacity(), size_);
+        UninitializedValueConstructN(data_.GetAddress(), size);
+    }
+
+    // Заполнение при создании идёт параллельным first-touch (см. FirstTouchTag)
+    constexpr Vector(size_t size, FirstTouchTag tag, const Alloc& alloc = Alloc()) : Vector(alloc) {
+        Resize(size, tag);
+    }
+
+    constexpr Vector(const Vector& other)
+        : data_(other.size_, other.data_.GetAllocator()), size_(other.size_) {
+        Annotate(Capacity(), size_);
+        UninitializedCopyN(other.data_.GetAddress(), size_, data_.GetAddress());
     }
     
-    Vector(Vector&& other) noexcept {
-        if (this == &other) {
-            return;
-        }
+    constexpr Vector(Vector&& other) noexcept : data_(0, other.data_.GetAllocator()) {
         Swap(other);
     }
+
+    // Конструктор по паре итераторов: для forward/random-access итераторов буфер
+    // выделяется сразу нужного размера и заполняется одним проходом
+    template <typename It, typename = typename std::iterator_traits<It>::iterator_category>
+    constexpr Vector(It first, It last, const Alloc& alloc = Alloc()) : data_(0, alloc) {
+        AppendRange(first, last);
+    }
     
-    Vector& operator = (const Vector& other) {
+    constexpr Vector& operator = (const Vector& other) {
         if (this == &other) {
             return *this;
         }
         if (other.size_ < size_) {
             std::copy(other.data_.GetAddress(), other.data_.GetAddress() + other.size_, data_.GetAddress());
             std::destroy_n(data_.GetAddress() + other.size_, size_ - other.size_);
+            Annotate(size_, other.size_);
             size_ = other.size_;
             return *this;
         }
         if (other.size_ <= Capacity()) {
+            Annotate(size_, other.size_);
             std::copy(other.data_.GetAddress(), other.data_.GetAddress() + size_, data_.GetAddress());
-            std::uninitialized_copy_n(other.data_.GetAddress() + size_, other.size_ - size_, data_.GetAddress() + size_);
+            UninitializedCopyN(other.data_.GetAddress() + size_, other.size_ - size_, data_.GetAddress() + size_);
             size_ = other.size_;
             return *this;
         }
@@ -138,8 +569,8 @@ public:
         Swap(tmp);
         return *this;
     }
-    
-    Vector& operator = (Vector&& other) noexcept {
+
+    constexpr Vector& operator = (Vector&& other) noexcept {
         if (this == &other) {
             return *this;
         }
@@ -147,178 +578,862 @@ public:
         return *this;
     }
     
-    ~Vector() noexcept {
+    constexpr ~Vector() noexcept {
         std::destroy_n(data_.GetAddress(), size_);
     }
-    
-    void Reserve(size_t new_capacity) {
+
+    constexpr void Reserve(size_t new_capacity) {
+        new_capacity = std::max(new_capacity, Growth::RoundUp(new_capacity));
         if (new_capacity <= data_.Capacity()) {
             return;
         }
-        RawMemory<T> new_data(new_capacity);
-        if constexpr (is_movable) {
-            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
-        } else {
-            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+        RelocateToBuffer(new_capacity);
+    }
+
+    // Уменьшает вместимость до текущего размера, возвращая лишнюю память аллокатору
+    constexpr void ShrinkToFit() {
+        ShrinkTo(size_);
+    }
+
+    // Урезает вместимость до max(new_capacity, Size()); если вместимость уже
+    // не больше запрошенной, ничего не делает
+    constexpr void ShrinkTo(size_t new_capacity) {
+        new_capacity = std::max(new_capacity, size_);
+        if (new_capacity >= Capacity()) {
+            return;
         }
-        std::destroy_n(data_.GetAddress(), size_);
-        data_.Swap(new_data);
+        if (new_capacity == 0) {
+            // Аллокатору с reallocate опустошение сообщается явно: ему может
+            // быть важно увидеть сжатие до нуля (MmapFileAllocator урезает
+            // файл, иначе при следующем открытии воскресли бы старые данные)
+            if (!std::is_constant_evaluated()) {
+                if constexpr (is_trivially_relocatable && AllocHasReallocate<Alloc, T>::value) {
+                    data_.Reallocate(0);
+                    return;
+                }
+            }
+            RawMemory<T, Alloc> empty(0, data_.GetAllocator());
+            data_.Swap(empty);
+            return;
+        }
+        RelocateToBuffer(new_capacity);
     }
     
     template <typename Type>
-    void PushBack(Type&& value) {
+    constexpr void PushBack(Type&& value) {
         EmplaceBack(std::forward<Type> (value));
     }
-    
+
+    // Горячий путь append-only циклов: при свободной вместимости — только
+    // placement-new и инкремент, без вычисления позиции и проверок вставки
+    // в середину; рост вынесен в отдельную холодную функцию
     template <typename... Args>
-    T& EmplaceBack(Args&&... args) {
-        Emplace(end(), std::forward<Args> (args)...);
-        return *(end() - 1);
+    constexpr T& EmplaceBack(Args&&... args) {
+        if (size_ < Capacity()) [[likely]] {
+            Annotate(size_, size_ + 1);
+            T* ptr = std::construct_at(data_.GetAddress() + size_, std::forward<Args> (args)...);
+            ++size_;
+            return *ptr;
+        }
+        return EmplaceBackWithReallocation(std::forward<Args> (args)...);
     }
     
-    void PopBack() {
+    // Дописывает [first, last) в конец. Для forward-итераторов вместимость
+    // резервируется один раз, элементы конструируются одним bulk-проходом
+    // (для тривиально копируемых типов и указателей — через memcpy).
+    // Диапазон не должен указывать внутрь самого вектора.
+    template <typename It>
+    constexpr void AppendRange(It first, It last) {
+        using Category = typename std::iterator_traits<It>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            if (size_ + count > Capacity()) {
+                Reserve(Growth::Grow(Capacity(), size_ + count));
+            }
+            Annotate(size_, size_ + count);
+            // memcpy допустим только для указателя ровно на T: указатель на
+            // другой тип (int* в Vector<double>) обязан идти через конверсию
+            if constexpr (is_trivially_copyable && std::is_pointer_v<It>
+                          && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<It>>, T>) {
+                if (!std::is_constant_evaluated()) {
+                    if (count != 0) {
+                        std::memcpy(static_cast<void*>(end()), static_cast<const void*>(first), count * sizeof(T));
+                    }
+                    size_ += count;
+                    return;
+                }
+            }
+            UninitializedCopy(first, last, end());
+            size_ += count;
+        } else {
+            for (; first != last; ++first) {
+                PushBack(*first);
+            }
+        }
+    }
+
+    // Замещает содержимое элементами [first, last), переиспользуя буфер и
+    // уже построенные элементы по образцу копирующего присваивания
+    template <typename It>
+    constexpr void Assign(It first, It last) {
+        using Category = typename std::iterator_traits<It>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            if (count < size_) {
+                std::copy(first, last, begin());
+                std::destroy_n(begin() + count, size_ - count);
+                Annotate(size_, count);
+                size_ = count;
+                return;
+            }
+            if (count <= Capacity()) {
+                Annotate(size_, count);
+                It mid = std::next(first, size_);
+                std::copy(first, mid, begin());
+                UninitializedCopy(mid, last, end());
+                size_ = count;
+                return;
+            }
+            Vector tmp(first, last, data_.GetAllocator());
+            Swap(tmp);
+        } else {
+            std::destroy_n(begin(), size_);
+            Annotate(size_, 0);
+            size_ = 0;
+            for (; first != last; ++first) {
+                PushBack(*first);
+            }
+        }
+    }
+
+    constexpr void PopBack() {
         assert(size_ != 0);
         std::destroy_at(begin() + size_ - 1);
         --size_;
+        Annotate(size_ + 1, size_);
     }
-    
+
+    // Разрушает элементы, сохраняя буфер: повторное наполнение той же
+    // вместимости не обращается к куче
+    constexpr void Clear() noexcept {
+        std::destroy_n(data_.GetAddress(), size_);
+        Annotate(size_, 0);
+        size_ = 0;
+    }
+
     template <typename Type>
-    iterator Insert(const_iterator pos, Type&& value) {
+    constexpr iterator Insert(const_iterator pos, Type&& value) {
         return Emplace(pos, std::forward<Type> (value));
     }
-    
+
     template <typename... Args>
-    iterator Emplace(const_iterator pos, Args&&... args) {
-        
+    constexpr iterator Emplace(const_iterator pos, Args&&... args) {
+
         size_t index = std::distance(cbegin(), pos);
-        
+
         if (index == size_ && size_ < Capacity()) {
-            new (begin() + size_) T(std::forward<Args> (args)...);
+            Annotate(size_, size_ + 1);
+            std::construct_at(begin() + size_, std::forward<Args> (args)...);
             ++size_;
             return end() - 1;
         }
-        
+
         if (size_ < Capacity()) {
+            Annotate(size_, size_ + 1);
+            if constexpr (is_trivially_copyable) {
+                if (!std::is_constant_evaluated()) {
+                    // Значение конструируется до сдвига: args могут ссылаться на элементы этого же вектора
+                    T value = T(std::forward<Args> (args)...);
+                    std::memmove(begin() + index + 1, begin() + index, (size_ - index) * sizeof(T));
+                    data_[index] = value;
+                    ++size_;
+                    return begin() + index;
+                }
+            }
             T value = T(std::forward<Args> (args)...);
-            new (end()) T(std::forward<T> (*(end() - 1)));
+            std::construct_at(end(), std::forward<T> (*(end() - 1)));
             std::move_backward(begin() + index, end() - 1, end());
             data_[index] = std::move(value);
             ++size_;
             return begin() + index;
         }
-        
+
         return EmplaceWithReallocation(index, std::forward<Args> (args)...);
     }
     
     
-    iterator Erase(const_iterator pos) {
+    // Вставляет [first, last) перед pos, открывая k-широкую брешь одним
+    // сдвигом хвоста (или одним проходом переноса при росте) вместо k
+    // одиночных Insert со сдвигом на каждый. Диапазон не должен указывать
+    // внутрь самого вектора
+    template <typename It>
+    constexpr iterator InsertRange(const_iterator pos, It first, It last) {
+        const size_t index = std::distance(cbegin(), pos);
+        using Category = typename std::iterator_traits<It>::iterator_category;
+        if constexpr (!std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            // Однопроходный источник сначала собирается в буфер
+            Vector buffered(data_.GetAllocator());
+            buffered.AppendRange(first, last);
+            return InsertRange(cbegin() + index, buffered.begin(), buffered.end());
+        } else {
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            if (count == 0) {
+                return begin() + index;
+            }
+            if (size_ + count > Capacity()) {
+                return InsertRangeWithReallocation(index, count, first, last);
+            }
+            Annotate(size_, size_ + count);
+            // Как и в AppendRange: memcpy только для указателя ровно на T,
+            // иначе разнотипный источник читался бы как сырые байты T
+            if constexpr (is_trivially_copyable && std::is_pointer_v<It>
+                          && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<It>>, T>) {
+                if (!std::is_constant_evaluated()) {
+                    std::memmove(begin() + index + count, begin() + index, (size_ - index) * sizeof(T));
+                    std::memcpy(static_cast<void*>(begin() + index), static_cast<const void*>(first), count * sizeof(T));
+                    size_ += count;
+                    return begin() + index;
+                }
+            }
+            const size_t tail_len = size_ - index;
+            if (tail_len > count) {
+                // Хвост длиннее бреши: последние k элементов переезжают в сырую
+                // память, остальной хвост сдвигается присваиванием
+                if constexpr (is_movable) {
+                    UninitializedMove(end() - count, end(), end());
+                    std::move_backward(begin() + index, end() - count, end());
+                } else {
+                    UninitializedCopy(end() - count, end(), end());
+                    std::copy_backward(begin() + index, end() - count, end());
+                }
+                size_ += count;
+                std::copy(first, last, begin() + index);
+            } else {
+                // Брешь шире хвоста: часть новых элементов конструируется за
+                // старым концом, весь хвост переезжает в сырую память целиком
+                It mid = std::next(first, static_cast<std::ptrdiff_t>(tail_len));
+                UninitializedCopy(mid, last, end());
+                VECTOR_TRY {
+                    if constexpr (is_movable) {
+                        UninitializedMove(begin() + index, end(), begin() + index + count);
+                    } else {
+                        UninitializedCopy(begin() + index, end(), begin() + index + count);
+                    }
+                } VECTOR_CATCH_ALL {
+                    std::destroy_n(end(), count - tail_len);
+                    VECTOR_RETHROW;
+                }
+                size_ += count;
+                std::copy(first, mid, begin() + index);
+            }
+            return begin() + index;
+        }
+    }
+
+    constexpr iterator Erase(const_iterator pos) {
         assert(size_ != 0);
-        size_t index = std::distance(cbegin(), pos);
-        std::destroy_at(pos);
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет [first, last) одним сдвигом хвоста: стоимость не зависит
+    // от числа удаляемых элементов
+    constexpr iterator Erase(const_iterator first, const_iterator last) {
+        const size_t index = std::distance(cbegin(), first);
+        const size_t count = std::distance(first, last);
+        assert(index + count <= size_);
+        if (count == 0) {
+            return begin() + index;
+        }
+        if constexpr (is_trivially_copyable) {
+            if (!std::is_constant_evaluated()) {
+                std::memmove(begin() + index, begin() + index + count, (size_ - index - count) * sizeof(T));
+                size_ -= count;
+                Annotate(size_ + count, size_);
+                return begin() + index;
+            }
+        }
+        // Сначала сдвигаем хвост присваиванием, затем разрушаем освободившийся
+        // конец — присваивать в разрушенный элемент нельзя
         if constexpr (is_movable) {
-            std::move(begin() + index + 1, end(), begin() + index);
+            std::move(begin() + index + count, end(), begin() + index);
         } else {
-            std::copy(begin() + index + 1, end(), begin() + index);
+            std::copy(begin() + index + count, end(), begin() + index);
+        }
+        std::destroy_n(begin() + (size_ - count), count);
+        size_ -= count;
+        Annotate(size_ + count, size_);
+        return begin() + index;
+    }
+
+    // O(1): на место удаляемого встаёт последний элемент, порядок не сохраняется
+    constexpr iterator EraseUnordered(const_iterator pos) {
+        assert(size_ != 0);
+        const size_t index = std::distance(cbegin(), pos);
+        assert(index < size_);
+        if (index + 1 != size_) {
+            if constexpr (is_movable) {
+                begin()[index] = std::move(begin()[size_ - 1]);
+            } else {
+                begin()[index] = begin()[size_ - 1];
+            }
         }
+        std::destroy_at(begin() + (size_ - 1));
         --size_;
+        Annotate(size_ + 1, size_);
         return begin() + index;
     }
+
+    // Удаляет все элементы, удовлетворяющие pred, одним уплотняющим проходом;
+    // возвращает число удалённых
+    template <typename Pred>
+    constexpr size_t EraseIf(Pred pred) {
+        iterator out = begin();
+        for (iterator it = begin(); it != end(); ++it) {
+            if (!pred(*it)) {
+                if (out != it) {
+                    if constexpr (is_movable) {
+                        *out = std::move(*it);
+                    } else {
+                        *out = *it;
+                    }
+                }
+                ++out;
+            }
+        }
+        const size_t removed = end() - out;
+        std::destroy_n(out, removed);
+        size_ -= removed;
+        Annotate(size_ + removed, size_);
+        return removed;
+    }
     
-    void Resize(size_t new_size) {
+    constexpr void Resize(size_t new_size) {
         if (new_size <= size_) {
             std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
+            Annotate(size_, new_size);
             size_ = new_size;
             return;
         }
         if (new_size <= Capacity()) {
-            std::uninitialized_value_construct_n(data_.GetAddress() + size_, new_size - size_);
+            Annotate(size_, new_size);
+            UninitializedValueConstructN(data_.GetAddress() + size_, new_size - size_);
             size_ = new_size;
             return;
         }
         Reserve(new_size);
-        std::uninitialized_value_construct_n(data_.GetAddress() + size_, new_size - size_);
+        Annotate(size_, new_size);
+        UninitializedValueConstructN(data_.GetAddress() + size_, new_size - size_);
         size_ = new_size;
     }
     
-    void Swap(Vector& other) noexcept {
+    // Resize без инициализации: новые элементы конструируются по умолчанию,
+    // для тривиальных типов это не стоит ничего (память не обнуляется)
+    constexpr void Resize(size_t new_size, DefaultInitTag) {
+        if (new_size <= size_) {
+            Resize(new_size);
+            return;
+        }
+        Reserve(new_size);
+        Annotate(size_, new_size);
+        UninitializedDefaultConstructN(data_.GetAddress() + size_, new_size - size_);
+        size_ = new_size;
+    }
+
+    // Resize с параллельным first-touch: куски нового хвоста
+    // value-конструируются каждый своим потоком (только для типов с
+    // nothrow-конструктором по умолчанию — межпоточного отката нет)
+    constexpr void Resize(size_t new_size, FirstTouchTag) {
+#ifdef VECTOR_ENABLE_PARALLEL_RELOCATION
+        if constexpr (std::is_nothrow_default_constructible_v<T>) {
+            if (!std::is_constant_evaluated() && new_size > size_) {
+                Reserve(new_size);
+                Annotate(size_, new_size);
+                T* tail = data_.GetAddress() + size_;
+                ParallelForChunks(new_size - size_, [tail](size_t offset, size_t len) {
+                    std::uninitialized_value_construct_n(tail + offset, len);
+                });
+                size_ = new_size;
+                return;
+            }
+        }
+#endif
+        Resize(new_size);
+    }
+
+    // Resize с заполнением новых элементов копиями value
+    constexpr void Resize(size_t new_size, const T& value) {
+        if (new_size <= size_) {
+            Resize(new_size);
+            return;
+        }
+        if (new_size <= Capacity()) {
+            Annotate(size_, new_size);
+            UninitializedFillN(data_.GetAddress() + size_, new_size - size_, value);
+            size_ = new_size;
+            return;
+        }
+        // Копия на случай, если value ссылается на элемент этого же вектора
+        T tmp(value);
+        Reserve(new_size);
+        Annotate(size_, new_size);
+        UninitializedFillN(data_.GetAddress() + size_, new_size - size_, tmp);
+        size_ = new_size;
+    }
+
+    // Дописывает count элементов, конструируя каждый прямо из generator(index)
+    // в сырой памяти — один проход по памяти вместо value-construct плюс
+    // присваивание. index — итоговый индекс элемента в векторе. generator
+    // вызывается после возможной реаллокации, поэтому не должен держать ссылки
+    // внутрь этого же вектора. При исключении дописанное разрушается
+    template <typename Generator>
+    constexpr void AppendWith(size_t count, Generator generator) {
+        if (size_ + count > Capacity()) {
+            Reserve(Growth::Grow(Capacity(), size_ + count));
+        }
+        Annotate(size_, size_ + count);
+        size_t appended = 0;
+        VECTOR_TRY {
+            while (appended < count) {
+                std::construct_at(data_.GetAddress() + size_ + appended, generator(size_ + appended));
+                ++appended;
+            }
+        } VECTOR_CATCH_ALL {
+            std::destroy_n(data_.GetAddress() + size_, appended);
+            Annotate(size_ + count, size_);
+            VECTOR_RETHROW;
+        }
+        size_ += count;
+    }
+
+    // Resize, заполняющий новые элементы значениями generator(index)
+    template <typename Generator>
+    constexpr void ResizeWith(size_t new_size, Generator generator) {
+        if (new_size <= size_) {
+            Resize(new_size);
+            return;
+        }
+        AppendWith(new_size - size_, std::move(generator));
+    }
+
+    constexpr void Swap(Vector& other) noexcept {
         data_.Swap(other.data_);
         std::swap(size_, other.size_);
     }
-    
-    size_t Size() const noexcept {
+
+    // Снимок в поток: заголовок с числом элементов, затем буфер одним write —
+    // для тривиально копируемых T их байтовое представление и есть формат
+    // (привязанный к платформе, как и сам T)
+    void WriteTo(std::ostream& out) const {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "bulk WriteTo needs trivially copyable elements; pass a write_element callback");
+        WriteHeader(out, size_);
+        if (size_ != 0) {
+            out.write(reinterpret_cast<const char*>(data_.GetAddress()),
+                      static_cast<std::streamsize>(size_ * sizeof(T)));
+        }
+    }
+
+    // Поэлементный вариант для остальных типов: write_element(out, element)
+    template <typename WriteElement>
+    void WriteTo(std::ostream& out, WriteElement write_element) const {
+        WriteHeader(out, size_);
+        for (size_t i = 0; i < size_; ++i) {
+            write_element(out, data_[i]);
+        }
+    }
+
+    // Читает снимок, записанный WriteTo: один read прямо в буфер
+    static Vector ReadFrom(std::istream& in, const Alloc& alloc = Alloc()) {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "bulk ReadFrom needs trivially copyable elements; pass a read_element callback");
+        const size_t count = ReadHeader(in);
+        Vector result(alloc);
+        result.Reserve(count);
+        result.Annotate(result.size_, count);
+        if (count != 0) {
+            in.read(reinterpret_cast<char*>(result.data_.GetAddress()),
+                    static_cast<std::streamsize>(count * sizeof(T)));
+            if (!in) {
+                throw std::runtime_error("Vector::ReadFrom: truncated snapshot");
+            }
+        }
+        result.size_ = count;
+        return result;
+    }
+
+    // Поэлементный вариант: read_element(in) возвращает очередной элемент
+    template <typename ReadElement,
+              std::enable_if_t<std::is_invocable_v<ReadElement&, std::istream&>, int> = 0>
+    static Vector ReadFrom(std::istream& in, ReadElement read_element, const Alloc& alloc = Alloc()) {
+        const size_t count = ReadHeader(in);
+        Vector result(alloc);
+        result.Reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            result.EmplaceBack(read_element(in));
+        }
+        return result;
+    }
+
+    constexpr size_t Size() const noexcept {
         return size_;
     }
 
-    size_t Capacity() const noexcept {
+    constexpr size_t Capacity() const noexcept {
         return data_.Capacity();
     }
 
-    const T& operator[](size_t index) const noexcept {
+    constexpr const T& operator[](size_t index) const noexcept {
         return const_cast<Vector&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
+    constexpr T& operator[](size_t index) noexcept {
         assert(index < size_);
         return data_[index];
     }
-    
-    iterator begin() noexcept {
+
+    // Доступ с проверкой границ для hardened-сборок: при определённом
+    // VECTOR_HARDENED_BOUNDS выход за Size() немедленно завершает процесс
+    // (без него At эквивалентен operator[] и компилируется в то же самое)
+    constexpr const T& At(size_t index) const noexcept {
+        return const_cast<Vector&>(*this).At(index);
+    }
+
+    constexpr T& At(size_t index) noexcept {
+#ifdef VECTOR_HARDENED_BOUNDS
+        if (index >= size_) {
+            std::abort();
+        }
+#endif
+        return (*this)[index];
+    }
+
+    constexpr iterator begin() noexcept {
         return data_.GetAddress();
     }
-    iterator end() noexcept {
+    constexpr iterator end() noexcept {
         return data_ + size_;
     }
-    const_iterator begin() const noexcept {
+    constexpr const_iterator begin() const noexcept {
         return data_.GetAddress();
     }
-    const_iterator end() const noexcept {
+    constexpr const_iterator end() const noexcept {
         return data_ + size_;
     }
-    const_iterator cbegin() const noexcept {
+    constexpr const_iterator cbegin() const noexcept {
         return data_.GetAddress();
     }
-    const_iterator cend() const noexcept {
+    constexpr const_iterator cend() const noexcept {
         return data_ + size_;
     }
 
+    constexpr const Alloc& GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
+    // Принимает без копирования буфер с size сконструированными элементами и
+    // вместимостью capacity; буфер должен быть выделен совместимо с Alloc
+    // (например, получен из Release или из alloc.allocate)
+    static constexpr Vector Adopt(T* buf, size_t size, size_t capacity, const Alloc& alloc = Alloc()) {
+        assert(size <= capacity);
+        Vector result(alloc);
+        RawMemory<T, Alloc> adopted(buf, capacity, alloc);
+        result.data_.Swap(adopted);
+        result.size_ = size;
+        result.Annotate(capacity, size);
+        return result;
+    }
+
+    // Построение из перечисленных значений — замена braced-list: у
+    // initializer_list элементы const и их пришлось бы копировать. Буфер
+    // выделяется один раз ровно под число аргументов, каждый аргумент
+    // пробрасывается в конструктор на месте, так что годятся и move-only типы:
+    //   auto v = Vector<std::unique_ptr<int>>::Of(std::make_unique<int>(1), ...);
+    template <typename... Args>
+    static constexpr Vector Of(Args&&... args) {
+        Vector result;
+        result.Reserve(sizeof...(Args));
+        (result.EmplaceBack(std::forward<Args>(args)), ...);
+        return result;
+    }
+
+    struct ReleasedBuffer {
+        T* buffer;
+        size_t size;
+        size_t capacity;
+    };
+
+    // Отдаёт буфер вызывающему вместе с владением, вектор остаётся пустым.
+    // Элементы (size штук) остаются сконструированными; освободить буфер нужно
+    // аллокатором Alloc после их разрушения — или вернуть его обратно через Adopt
+    constexpr ReleasedBuffer Release() noexcept {
+        Annotate(size_, Capacity());  // внешний владелец получает буфер без отметок
+        ReleasedBuffer released{nullptr, size_, Capacity()};
+        released.buffer = data_.Release();
+        size_ = 0;
+        return released;
+    }
+
+#ifdef VECTOR_ENABLE_STATS
+    const VectorStats& Stats() const noexcept {
+        return stats_;
+    }
+
+    size_t WastedCapacity() const noexcept {
+        return Capacity() - Size();
+    }
+#endif
+
 private:
-    RawMemory<T> data_;
+    RawMemory<T, Alloc> data_;
     size_t size_ = 0;
+#ifdef VECTOR_ENABLE_STATS
+    VectorStats stats_;
+#endif
+
+    // Учитывает перенос size_ элементов в буфер новой вместимости;
+    // без VECTOR_ENABLE_STATS не генерирует ни одной инструкции
+    // Перемечает для ASan границу построенного: [0, new_mid) валидно,
+    // [new_mid, Capacity()) отравлено. Вызывается ДО конструирования новых
+    // элементов и ПОСЛЕ разрушения лишних. Только для буферов из
+    // operator new — ASan снимает отметки при их освобождении сам
+    constexpr void Annotate([[maybe_unused]] size_t old_mid, [[maybe_unused]] size_t new_mid) const {
+#ifdef VECTOR_HAS_ASAN
+        if constexpr (std::is_same_v<Alloc, NewDeleteAllocator<T>>) {
+            if (!std::is_constant_evaluated() && Capacity() != 0) {
+                const T* beg = data_.GetAddress();
+                __sanitizer_annotate_contiguous_container(
+                    beg, beg + Capacity(), beg + old_mid, beg + new_mid);
+            }
+        }
+#endif
+    }
+
+    constexpr void RecordReallocation(size_t new_capacity) {
+#ifdef VECTOR_ENABLE_STATS
+        if (!std::is_constant_evaluated()) {
+            ++stats_.reallocations;
+            stats_.elements_relocated += size_;
+            stats_.peak_capacity = std::max(stats_.peak_capacity, new_capacity);
+            VectorStats::total_reallocations.fetch_add(1, std::memory_order_relaxed);
+            VectorStats::total_elements_relocated.fetch_add(size_, std::memory_order_relaxed);
+            if (VectorStats::on_reallocation) {
+                VectorStats::on_reallocation(this, new_capacity, size_);
+            }
+        }
+#endif
+        (void)new_capacity;
+    }
     
-    template <typename... Args>
-    iterator EmplaceWithReallocation(size_t index, Args&&... args) {
-        RawMemory<T> tmp(size_ == 0 ? 1 : 2 * size_);
-        T* ptr_new = new (tmp + index) T(std::forward<Args> (args)...);
+    static void WriteHeader(std::ostream& out, size_t count) {
+        const uint64_t header = count;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    static size_t ReadHeader(std::istream& in) {
+        uint64_t header = 0;
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!in) {
+            throw std::runtime_error("Vector::ReadFrom: missing snapshot header");
+        }
+        return static_cast<size_t>(header);
+    }
+
+    // Переносит элементы в буфер вместимости new_capacity (>= Size()),
+    // расширяя блок на месте, когда аллокатор умеет realloc
+    constexpr void RelocateToBuffer(size_t new_capacity) {
+        RecordReallocation(new_capacity);
+        if (!std::is_constant_evaluated()) {
+            if constexpr (is_trivially_relocatable && AllocHasReallocate<Alloc, T>::value) {
+                // realloc-способный аллокатор обычно меняет размер блока на месте
+                data_.Reallocate(new_capacity);
+                return;
+            }
+        }
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+        if constexpr (is_trivially_relocatable) {
+            // Побайтовый перенос заменяет пару "переместить + разрушить источник"
+            if (!std::is_constant_evaluated()) {
+                if (size_ != 0) {
+#ifdef VECTOR_ENABLE_PARALLEL_RELOCATION
+                    ParallelRelocate(data_.GetAddress(), size_, new_data.GetAddress(),
+                                     [](T* src, size_t count, T* dst) {
+                                         RelocateBytes(dst, src, count * sizeof(T));
+                                     });
+#else
+                    RelocateBytes(new_data.GetAddress(), data_.GetAddress(), size_ * sizeof(T));
+#endif
+                }
+                data_.Swap(new_data);
+                Annotate(Capacity(), size_);
+                return;
+            }
+        }
+#ifdef VECTOR_ENABLE_PARALLEL_RELOCATION
+        if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                // Каждый кусок переносится и разрушается своим потоком
+                ParallelRelocate(data_.GetAddress(), size_, new_data.GetAddress(),
+                                 [](T* src, size_t count, T* dst) {
+                                     std::uninitialized_move_n(src, count, dst);
+                                     std::destroy_n(src, count);
+                                 });
+                data_.Swap(new_data);
+                Annotate(Capacity(), size_);
+                return;
+            }
+        }
+#endif
         if constexpr (is_movable) {
-            try {
-                std::uninitialized_move(begin(), begin() + index, tmp.GetAddress());
-            } catch (...) {
+            UninitializedMoveN(data_.GetAddress(), size_, new_data.GetAddress());
+        } else {
+            UninitializedCopyN(data_.GetAddress(), size_, new_data.GetAddress());
+        }
+        std::destroy_n(data_.GetAddress(), size_);
+        data_.Swap(new_data);
+        Annotate(Capacity(), size_);
+    }
+
+    // Холодная часть EmplaceBack: вынесена из строки вызова и не инлайнится,
+    // чтобы горячий путь компилировался в пару инструкций
+    template <typename... Args>
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((noinline, cold))
+#endif
+    constexpr T& EmplaceBackWithReallocation(Args&&... args) {
+        return *EmplaceWithReallocation(size_, std::forward<Args> (args)...);
+    }
+
+    // Рост со вставкой диапазона за один проход переноса: вставляемые элементы
+    // конструируются в новом буфере первыми, затем префикс и хвост переезжают
+    // по обе стороны от них — обобщение разрезного переноса EmplaceWithReallocation
+    template <typename It>
+    constexpr iterator InsertRangeWithReallocation(size_t index, size_t count, It first, It last) {
+        const size_t new_capacity = Growth::Grow(Capacity(), size_ + count);
+        RecordReallocation(new_capacity);
+        RawMemory<T, Alloc> tmp(new_capacity, data_.GetAllocator());
+        // При исключении std-алгоритм сам разрушает частично построенное
+        UninitializedCopy(first, last, tmp + index);
+        if constexpr (is_trivially_relocatable) {
+            if (!std::is_constant_evaluated()) {
+                RelocateBytes(tmp.GetAddress(), begin(), index * sizeof(T));
+                RelocateBytes(tmp.GetAddress() + index + count, begin() + index, (size_ - index) * sizeof(T));
+                size_ += count;
+                data_.Swap(tmp);
+                Annotate(Capacity(), size_);
+                return begin() + index;
+            }
+        }
+        if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            UninitializedMove(begin(), begin() + index, tmp.GetAddress());
+            UninitializedMove(begin() + index, end(), tmp.GetAddress() + index + count);
+        } else if constexpr (is_movable) {
+            VECTOR_TRY {
+                UninitializedMove(begin(), begin() + index, tmp.GetAddress());
+            } VECTOR_CATCH_ALL {
+                std::destroy_n(tmp + index, count);
+                VECTOR_RETHROW;
+            }
+            VECTOR_TRY {
+                UninitializedMove(begin() + index, end(), tmp.GetAddress() + index + count);
+            } VECTOR_CATCH_ALL {
+                std::destroy_n(tmp.GetAddress(), index);
+                std::destroy_n(tmp + index, count);
+                VECTOR_RETHROW;
+            }
+        } else {
+            VECTOR_TRY {
+                UninitializedCopy(begin(), begin() + index, tmp.GetAddress());
+            } VECTOR_CATCH_ALL {
+                std::destroy_n(tmp + index, count);
+                VECTOR_RETHROW;
+            }
+            VECTOR_TRY {
+                UninitializedCopy(begin() + index, end(), tmp.GetAddress() + index + count);
+            } VECTOR_CATCH_ALL {
+                std::destroy_n(tmp.GetAddress(), index);
+                std::destroy_n(tmp + index, count);
+                VECTOR_RETHROW;
+            }
+        }
+        const size_t old_size = size_;
+        size_ += count;
+        data_.Swap(tmp);
+        Annotate(Capacity(), size_);
+        std::destroy_n(tmp.GetAddress(), old_size);
+        return begin() + index;
+    }
+
+    template <typename... Args>
+    constexpr iterator EmplaceWithReallocation(size_t index, Args&&... args) {
+        RecordReallocation(Growth::Grow(Capacity(), size_ + 1));
+        if (!std::is_constant_evaluated()) {
+            if constexpr (is_trivially_relocatable && AllocHasReallocate<Alloc, T>::value) {
+                // Значение материализуется до realloc: args могут ссылаться на элементы вектора
+                alignas(T) unsigned char value_buf[sizeof(T)];
+                T* value = new (value_buf) T(std::forward<Args> (args)...);
+                VECTOR_TRY {
+                    data_.Reallocate(Growth::Grow(Capacity(), size_ + 1));
+                } VECTOR_CATCH_ALL {
+                    std::destroy_at(value);
+                    VECTOR_RETHROW;
+                }
+                std::memmove(static_cast<void*>(begin() + index + 1),
+                             static_cast<const void*>(begin() + index), (size_ - index) * sizeof(T));
+                // value намеренно не разрушается: его содержимое перенесено побайтово
+                std::memcpy(static_cast<void*>(begin() + index), static_cast<const void*>(value), sizeof(T));
+                ++size_;
+                return begin() + index;
+            }
+        }
+        RawMemory<T, Alloc> tmp(Growth::Grow(Capacity(), size_ + 1), data_.GetAllocator());
+        T* ptr_new = std::construct_at(tmp + index, std::forward<Args> (args)...);
+        if constexpr (is_trivially_relocatable) {
+            if (!std::is_constant_evaluated()) {
+                if (size_ != 0) {
+                    RelocateBytes(tmp.GetAddress(), begin(), index * sizeof(T));
+                    RelocateBytes(tmp.GetAddress() + index + 1, begin() + index, (size_ - index) * sizeof(T));
+                }
+                ++size_;
+                data_.Swap(tmp);
+                Annotate(Capacity(), size_);
+                return begin() + index;
+            }
+        }
+        if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            // Перемещения не бросают: мёртвая catch-очистка только мешала
+            // инлайнингу и раздувала горячий путь роста
+            UninitializedMove(begin(), begin() + index, tmp.GetAddress());
+            UninitializedMove(begin() + index, end(), tmp.GetAddress() + index + 1);
+        } else if constexpr (is_movable) {
+            VECTOR_TRY {
+                UninitializedMove(begin(), begin() + index, tmp.GetAddress());
+            } VECTOR_CATCH_ALL {
                 std::destroy_at(ptr_new);
-                throw;
+                VECTOR_RETHROW;
             }
-            try {
-                std::uninitialized_move(begin() + index, end(), tmp.GetAddress() + index + 1);
-            } catch (...) {
+            VECTOR_TRY {
+                UninitializedMove(begin() + index, end(), tmp.GetAddress() + index + 1);
+            } VECTOR_CATCH_ALL {
                 std::destroy_n(tmp.GetAddress(), index + 1);
-                throw;
+                VECTOR_RETHROW;
             }
-            
         } else {
-            try {
-                std::uninitialized_copy(begin(), begin() + index, tmp.GetAddress());
-            } catch (...) {
+            VECTOR_TRY {
+                UninitializedCopy(begin(), begin() + index, tmp.GetAddress());
+            } VECTOR_CATCH_ALL {
                 std::destroy_at(ptr_new);
-                throw;
+                VECTOR_RETHROW;
             }
-            try {
-                std::uninitialized_copy(begin() + index, end(), tmp.GetAddress() + index + 1);
-            } catch (...) {
+            VECTOR_TRY {
+                UninitializedCopy(begin() + index, end(), tmp.GetAddress() + index + 1);
+            } VECTOR_CATCH_ALL {
                 std::destroy_n(tmp.GetAddress(), index + 1);
-                throw;
+                VECTOR_RETHROW;
             }
         }
         ++size_;
         data_.Swap(tmp);
+        Annotate(Capacity(), size_);
         std::destroy_n(tmp.GetAddress(), size_ - 1);
         return begin() + index;
     }